@@ -0,0 +1,148 @@
+#pragma once
+
+#include "impl/base.h"
+#include <cstddef>
+
+namespace xlang
+{
+    // A monotonic arena for transient allocations that share a lifetime, such as the strings and containers that a
+    // writer creates while writing a file. Individual allocations are never freed. Instead, the arena releases all of
+    // its memory at once when it is destroyed.
+
+    struct arena
+    {
+        arena(arena const&) = delete;
+        arena& operator=(arena const&) = delete;
+
+        arena() noexcept = default;
+
+        ~arena() noexcept
+        {
+            while (m_chunks)
+            {
+                auto next = m_chunks->next;
+                ::operator delete(m_chunks);
+                m_chunks = next;
+            }
+        }
+
+        void* allocate(std::size_t const size, std::size_t const alignment)
+        {
+            auto offset = (m_offset + alignment - 1) & ~(alignment - 1);
+
+            if (!m_chunks || offset + size > m_chunks->size)
+            {
+                add_chunk(size + alignment);
+                offset = (m_offset + alignment - 1) & ~(alignment - 1);
+            }
+
+            m_offset = offset + size;
+            return reinterpret_cast<char*>(m_chunks + 1) + offset;
+        }
+
+        // Copies the string into the arena so that it lives as long as the arena.
+        std::string_view copy(std::string_view const& value)
+        {
+            if (value.empty())
+            {
+                return {};
+            }
+
+            auto data = static_cast<char*>(allocate(value.size(), 1));
+            std::copy(value.begin(), value.end(), data);
+            return { data, value.size() };
+        }
+
+        // The number of bytes reserved from the heap, which includes any unused space at the end of each chunk.
+        std::size_t reserved() const noexcept
+        {
+            return m_reserved;
+        }
+
+    private:
+
+        // The chunk header is followed by the chunk's memory, which is then aligned for any fundamental type.
+        struct alignas(std::max_align_t) chunk
+        {
+            chunk* next;
+            std::size_t size;
+        };
+
+        void add_chunk(std::size_t const minimum)
+        {
+            // Chunks double in size so that a writer that produces a large file makes few trips to the heap.
+            std::size_t const initial = 4 * 1024;
+            std::size_t const maximum = 1024 * 1024;
+            auto size = (std::max)(minimum, m_chunks ? (std::min)(m_chunks->size * 2, maximum) : initial);
+
+            auto value = static_cast<chunk*>(::operator new(sizeof(chunk) + size));
+            value->next = m_chunks;
+            value->size = size;
+            m_chunks = value;
+            m_offset = 0;
+            m_reserved += size;
+        }
+
+        chunk* m_chunks{};
+        std::size_t m_offset{};
+        std::size_t m_reserved{};
+    };
+
+    // Allocates from an arena, or from the heap if default constructed, so that containers may use an arena
+    // without requiring every instance of the container type to have one.
+    template <typename T>
+    struct arena_allocator
+    {
+        using value_type = T;
+
+        arena_allocator() noexcept = default;
+
+        explicit arena_allocator(arena& owner) noexcept : m_arena(&owner)
+        {
+        }
+
+        template <typename U>
+        arena_allocator(arena_allocator<U> const& other) noexcept : m_arena(other.get_arena())
+        {
+        }
+
+        T* allocate(std::size_t const count)
+        {
+            if (m_arena)
+            {
+                return static_cast<T*>(m_arena->allocate(count * sizeof(T), alignof(T)));
+            }
+
+            return static_cast<T*>(::operator new(count * sizeof(T)));
+        }
+
+        void deallocate(T* const value, std::size_t) noexcept
+        {
+            if (!m_arena)
+            {
+                ::operator delete(value);
+            }
+        }
+
+        arena* get_arena() const noexcept
+        {
+            return m_arena;
+        }
+
+        template <typename U>
+        bool operator==(arena_allocator<U> const& other) const noexcept
+        {
+            return m_arena == other.get_arena();
+        }
+
+        template <typename U>
+        bool operator!=(arena_allocator<U> const& other) const noexcept
+        {
+            return m_arena != other.get_arena();
+        }
+
+    private:
+
+        arena* m_arena{};
+    };
+}
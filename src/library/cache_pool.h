@@ -0,0 +1,154 @@
+#pragma once
+
+#include "meta_reader.h"
+#include "type_model.h"
+#include <condition_variable>
+#include <mutex>
+
+namespace xlang::meta::reader
+{
+    // Shares metadata between generators that run concurrently in one process. Each generator requests its cache
+    // once, and requests are held until every generator has either made its request or finished. At that point
+    // each distinct set of files is loaded once, in parallel, and a type model is published for the most widely
+    // shared cache before any generator proceeds.
+
+    struct cache_pool
+    {
+        cache_pool(cache_pool const&) = delete;
+        cache_pool& operator=(cache_pool const&) = delete;
+
+        explicit cache_pool(std::size_t clients) : m_waiting(clients)
+        {
+            XLANG_ASSERT(current() == nullptr);
+            current() = this;
+        }
+
+        ~cache_pool() noexcept
+        {
+            current() = nullptr;
+        }
+
+        static cache_pool*& current() noexcept
+        {
+            static cache_pool* pool{};
+            return pool;
+        }
+
+        // Returns the pooled cache for the files if there is a pool, and otherwise loads the cache into storage.
+        static cache const& load(std::vector<std::string> const& files, std::optional<cache>& storage)
+        {
+            if (auto pool = current())
+            {
+                return pool->get(files);
+            }
+
+            return storage.emplace(files);
+        }
+
+        // Must be called on each client's thread when it finishes so that clients that fail, or finish, before
+        // requesting a cache don't hold up the others.
+        void finish()
+        {
+            std::unique_lock<std::mutex> guard{ m_lock };
+
+            if (!requested())
+            {
+                arrive(guard);
+            }
+
+            requested() = false;
+        }
+
+    private:
+
+        struct entry
+        {
+            std::size_t clients{};
+            std::unique_ptr<cache> value;
+        };
+
+        static bool& requested() noexcept
+        {
+            thread_local bool value{};
+            return value;
+        }
+
+        cache const& get(std::vector<std::string> const& files)
+        {
+            std::unique_lock<std::mutex> guard{ m_lock };
+            XLANG_ASSERT(!requested());
+            requested() = true;
+            auto& target = m_entries[files];
+            ++target.clients;
+            arrive(guard);
+
+            if (m_error)
+            {
+                std::rethrow_exception(m_error);
+            }
+
+            return *target.value;
+        }
+
+        void arrive(std::unique_lock<std::mutex>& guard)
+        {
+            XLANG_ASSERT(m_waiting != 0);
+
+            if (--m_waiting != 0)
+            {
+                m_ready.wait(guard, [&] { return m_loaded; });
+                return;
+            }
+
+            // Every other client is now waiting, so the entries may be loaded without holding the lock.
+            guard.unlock();
+
+            try
+            {
+                load_entries();
+            }
+            catch (...)
+            {
+                m_error = std::current_exception();
+            }
+
+            guard.lock();
+            m_loaded = true;
+            m_ready.notify_all();
+        }
+
+        void load_entries()
+        {
+            profile_scope profile{ "load_metadata" };
+            task_group group;
+
+            for (auto&&[files, target] : m_entries)
+            {
+                group.add([&files = files, &target = target]
+                {
+                    target.value = std::make_unique<cache>(files);
+                });
+            }
+
+            group.get();
+
+            auto shared = std::max_element(m_entries.begin(), m_entries.end(), [](auto const& left, auto const& right)
+            {
+                return left.second.clients < right.second.clients;
+            });
+
+            if (shared != m_entries.end() && !type_model::current(*shared->second.value))
+            {
+                m_model = std::make_unique<type_model>(*shared->second.value);
+            }
+        }
+
+        std::mutex m_lock;
+        std::condition_variable m_ready;
+        std::size_t m_waiting;
+        bool m_loaded{};
+        std::exception_ptr m_error;
+        std::map<std::vector<std::string>, entry> m_entries;
+        std::unique_ptr<type_model> m_model;
+    };
+}
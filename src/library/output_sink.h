@@ -0,0 +1,193 @@
+#pragma once
+
+#include "impl/base.h"
+#include "task_group.h"
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+namespace xlang::text
+{
+    struct output_sink
+    {
+        output_sink(output_sink const&) = delete;
+        output_sink& operator=(output_sink const&) = delete;
+
+        output_sink() : m_thread([this] { run(); })
+        {
+            XLANG_ASSERT(current() == nullptr);
+            current() = this;
+        }
+
+        ~output_sink() noexcept
+        {
+            {
+                std::lock_guard<std::mutex> guard{ m_lock };
+                m_closed = true;
+            }
+
+            m_wake.notify_one();
+            m_thread.join();
+            current() = nullptr;
+        }
+
+        // The sink for the current thread, which tasks added to a task_group inherit.
+        static output_sink*& current() noexcept
+        {
+            return current_output_sink();
+        }
+
+        // Debug builds write the file on the calling thread, as task_group runs its tasks inline, so that a failed
+        // write is reported where the file was generated and files are written in a predictable order.
+        //
+        // Otherwise the file is queued for the sink's thread. Files that are queued or being written hold on to their
+        // text, so a producer waits for the queue to drain below max_pending_bytes rather than letting every file
+        // pile up in memory when the disk cannot keep up. A single file larger than that is still accepted once the
+        // queue is empty.
+        void write(std::string filename, std::vector<char>&& first, std::vector<char>&& second)
+        {
+#if defined(XLANG_DEBUG)
+            write_file(filename, first, second);
+#else
+            auto const bytes = first.size() + second.size();
+
+            {
+                std::unique_lock<std::mutex> guard{ m_lock };
+
+                m_space.wait(guard, [&]
+                {
+                    return m_pending_bytes == 0 || m_pending_bytes + bytes <= max_pending_bytes;
+                });
+
+                m_pending_bytes += bytes;
+                m_pending.push_back({ std::move(filename), std::move(first), std::move(second) });
+            }
+
+            m_wake.notify_one();
+#endif
+        }
+
+        void get()
+        {
+            std::unique_lock<std::mutex> guard{ m_lock };
+            m_idle.wait(guard, [&] { return m_pending.empty() && !m_busy; });
+
+            if (m_error)
+            {
+                std::rethrow_exception(std::exchange(m_error, {}));
+            }
+        }
+
+        static bool file_equal(std::string const& filename, std::vector<char> const& first, std::vector<char> const& second)
+        {
+            if (!std::filesystem::exists(filename))
+            {
+                return false;
+            }
+
+            meta::reader::file_view file{ filename };
+
+            if (file.size() != first.size() + second.size())
+            {
+                return false;
+            }
+
+            if (!std::equal(first.begin(), first.end(), file.begin(), file.begin() + first.size()))
+            {
+                return false;
+            }
+
+            return std::equal(second.begin(), second.end(), file.begin() + first.size(), file.end());
+        }
+
+        static void write_file(std::string const& filename, std::vector<char> const& first, std::vector<char> const& second)
+        {
+            if (!file_equal(filename, first, second))
+            {
+                std::ofstream file{ filename, std::ios::out | std::ios::binary };
+                file.write(first.data(), first.size());
+                file.write(second.data(), second.size());
+            }
+        }
+
+    private:
+
+        static constexpr std::size_t max_pending_bytes{ 64 * 1024 * 1024 };
+
+        struct pending_file
+        {
+            std::string filename;
+            std::vector<char> first;
+            std::vector<char> second;
+        };
+
+        void run()
+        {
+            std::unique_lock<std::mutex> guard{ m_lock };
+
+            while (true)
+            {
+                m_wake.wait(guard, [&] { return !m_pending.empty() || m_closed; });
+
+                if (m_pending.empty())
+                {
+                    return;
+                }
+
+                // Drain everything queued so far as a single batch so that producers are only
+                // blocked on the lock for as long as it takes to swap the queue.
+                auto batch = std::move(m_pending);
+                m_pending.clear();
+                m_busy = true;
+                guard.unlock();
+
+                std::exception_ptr error;
+
+                for (auto&& file : batch)
+                {
+                    try
+                    {
+                        write_file(file.filename, file.first, file.second);
+                    }
+                    catch (...)
+                    {
+                        if (!error)
+                        {
+                            error = std::current_exception();
+                        }
+                    }
+
+                    auto const bytes = file.first.size() + file.second.size();
+                    file = {};
+
+                    guard.lock();
+                    m_pending_bytes -= bytes;
+                    guard.unlock();
+                    m_space.notify_all();
+                }
+
+                batch.clear();
+                guard.lock();
+                m_busy = false;
+
+                if (error && !m_error)
+                {
+                    m_error = error;
+                }
+
+                m_idle.notify_all();
+            }
+        }
+
+        std::mutex m_lock;
+        std::condition_variable m_wake;
+        std::condition_variable m_idle;
+        std::condition_variable m_space;
+        std::vector<pending_file> m_pending;
+        std::size_t m_pending_bytes{};
+        std::exception_ptr m_error;
+        bool m_busy{};
+        bool m_closed{};
+        std::thread m_thread;
+    };
+}
@@ -0,0 +1,266 @@
+#pragma once
+
+#include "impl/base.h"
+#include <atomic>
+#include <chrono>
+#include <mutex>
+
+namespace xlang
+{
+    // Collects timing events for the -profile option and saves them in the Chrome trace-event
+    // format, which can be loaded by chrome://tracing or Perfetto. Scopes are cheap when no
+    // profiler is active, so they can be left in place unconditionally.
+
+    struct profiler
+    {
+        profiler(profiler const&) = delete;
+        profiler& operator=(profiler const&) = delete;
+
+        explicit profiler(std::string filename) :
+            m_filename(std::move(filename)),
+            m_start(std::chrono::steady_clock::now())
+        {
+            XLANG_ASSERT(current() == nullptr);
+            m_events.reserve(16 * 1024);
+            current() = this;
+        }
+
+        ~profiler() noexcept
+        {
+            current() = nullptr;
+        }
+
+        static profiler*& current() noexcept
+        {
+            static profiler* instance{};
+            return instance;
+        }
+
+        // Incremented by the replacement operator new in profiler_new.h while a profiler is active.
+        static uint64_t& allocations() noexcept
+        {
+            thread_local uint64_t count{};
+            return count;
+        }
+
+        // Incremented by writer_base::flush_to_file.
+        static uint64_t& bytes_written() noexcept
+        {
+            thread_local uint64_t count{};
+            return count;
+        }
+
+        // The namespace of the innermost enclosing scope that named one.
+        static std::string_view& current_namespace() noexcept
+        {
+            thread_local std::string_view name;
+            return name;
+        }
+
+        struct event
+        {
+            std::string_view name;
+            std::string_view type_namespace;
+            std::chrono::steady_clock::time_point start;
+            std::chrono::steady_clock::duration duration;
+            uint32_t thread;
+            uint64_t bytes;
+            uint64_t allocations;
+        };
+
+        // The event's names are not copied and must outlive the call to save.
+        void add(event const& value)
+        {
+            std::lock_guard<std::mutex> guard{ m_lock };
+            m_events.push_back(value);
+        }
+
+        static uint32_t thread_id() noexcept
+        {
+            static std::atomic<uint32_t> next{};
+            thread_local uint32_t id{ ++next };
+            return id;
+        }
+
+        void save()
+        {
+            std::lock_guard<std::mutex> guard{ m_lock };
+            std::string json;
+            json.reserve(m_events.size() * 160 + 64);
+            json += "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+            bool first{ true };
+
+            for (auto&& event : m_events)
+            {
+                if (first)
+                {
+                    first = false;
+                }
+                else
+                {
+                    json += ",\n";
+                }
+
+                json += "{\"name\":\"";
+                append_escaped(json, event.name);
+                json += "\",\"cat\":\"";
+                json += event.type_namespace.empty() ? "tool" : "namespace";
+                json += "\",\"ph\":\"X\",\"pid\":1,\"tid\":";
+                json += std::to_string(event.thread);
+                json += ",\"ts\":";
+                json += std::to_string(microseconds(event.start - m_start));
+                json += ",\"dur\":";
+                json += std::to_string(microseconds(event.duration));
+                json += ",\"args\":{";
+
+                if (!event.type_namespace.empty())
+                {
+                    json += "\"namespace\":\"";
+                    append_escaped(json, event.type_namespace);
+                    json += "\",";
+                }
+
+                json += "\"bytes\":";
+                json += std::to_string(event.bytes);
+                json += ",\"allocations\":";
+                json += std::to_string(event.allocations);
+                json += "}}";
+            }
+
+            json += "\n]}\n";
+
+            std::ofstream file{ m_filename, std::ios::out | std::ios::binary };
+
+            if (!file.write(json.data(), json.size()))
+            {
+                throw_invalid("Could not write profile '", m_filename, "'");
+            }
+        }
+
+    private:
+
+        static int64_t microseconds(std::chrono::steady_clock::duration const& value) noexcept
+        {
+            return std::chrono::duration_cast<std::chrono::microseconds>(value).count();
+        }
+
+        static void append_escaped(std::string& json, std::string_view const& value)
+        {
+            for (auto&& c : value)
+            {
+                if (c == '"' || c == '\\')
+                {
+                    json += '\\';
+                }
+
+                json += c;
+            }
+        }
+
+        std::string m_filename;
+        std::chrono::steady_clock::time_point m_start;
+        std::mutex m_lock;
+        std::vector<profiler::event> m_events;
+    };
+
+    struct profile_scope
+    {
+        profile_scope(profile_scope const&) = delete;
+        profile_scope& operator=(profile_scope const&) = delete;
+
+        explicit profile_scope(std::string_view const& name, std::string_view const& type_namespace = {}) noexcept :
+            m_profiler(profiler::current())
+        {
+            if (!m_profiler)
+            {
+                return;
+            }
+
+            m_event.name = name;
+            m_previous_namespace = profiler::current_namespace();
+
+            if (!type_namespace.empty())
+            {
+                profiler::current_namespace() = type_namespace;
+            }
+
+            m_event.type_namespace = profiler::current_namespace();
+            m_event.bytes = profiler::bytes_written();
+            m_event.allocations = profiler::allocations();
+            m_event.start = std::chrono::steady_clock::now();
+        }
+
+        ~profile_scope() noexcept
+        {
+            if (!m_profiler)
+            {
+                return;
+            }
+
+            m_event.duration = std::chrono::steady_clock::now() - m_event.start;
+            m_event.bytes = m_bytes ? *m_bytes : profiler::bytes_written() - m_event.bytes;
+            m_event.allocations = profiler::allocations() - m_event.allocations;
+            m_event.thread = profiler::thread_id();
+            profiler::current_namespace() = m_previous_namespace;
+
+            try
+            {
+                m_profiler->add(m_event);
+            }
+            catch (...)
+            {
+            }
+        }
+
+        explicit operator bool() const noexcept
+        {
+            return m_profiler != nullptr;
+        }
+
+        // Overrides the default byte count, which is the number of bytes flushed to files on
+        // this thread while the scope was active.
+        void bytes(uint64_t value) noexcept
+        {
+            m_bytes = value;
+        }
+
+    private:
+
+        profiler* m_profiler;
+        profiler::event m_event{};
+        std::string_view m_previous_namespace;
+        std::optional<uint64_t> m_bytes;
+    };
+
+    // Returns the unqualified name of the function F for use as an event name.
+    template <auto F>
+    std::string_view profile_name()
+    {
+#if defined(_MSC_VER)
+        static constexpr std::string_view signature{ __FUNCSIG__ };
+#else
+        static constexpr std::string_view signature{ __PRETTY_FUNCTION__ };
+#endif
+        static std::string const name = []
+        {
+#if defined(_MSC_VER)
+            auto first = signature.find("profile_name<") + 13;
+            auto last = signature.find('(', first);
+#else
+            auto first = signature.find("F = ") + 4;
+            auto last = signature.find_first_of(";]", first);
+#endif
+            auto result = signature.substr(first, last - first);
+            auto pos = result.find_last_of(" :&");
+
+            if (pos != std::string_view::npos)
+            {
+                result = result.substr(pos + 1);
+            }
+
+            return std::string{ result };
+        }();
+
+        return name;
+    }
+}
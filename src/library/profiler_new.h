@@ -0,0 +1,49 @@
+#pragma once
+
+#include "profiler.h"
+#include <cstdlib>
+#include <new>
+
+// Replaces the global allocation functions so that profile scopes can report allocation counts. Allocations are
+// only counted while a profiler is active, and otherwise behave as the standard operator new does.
+// Include this header in exactly one translation unit per tool.
+
+void* operator new(std::size_t size)
+{
+    if (xlang::profiler::current())
+    {
+        ++xlang::profiler::allocations();
+    }
+
+    if (size == 0)
+    {
+        size = 1;
+    }
+
+    while (true)
+    {
+        if (auto result = std::malloc(size))
+        {
+            return result;
+        }
+
+        auto handler = std::get_new_handler();
+
+        if (!handler)
+        {
+            throw std::bad_alloc{};
+        }
+
+        handler();
+    }
+}
+
+void operator delete(void* value) noexcept
+{
+    std::free(value);
+}
+
+void operator delete(void* value, std::size_t) noexcept
+{
+    std::free(value);
+}
@@ -1,9 +1,24 @@
 #pragma once
 
 #include "impl/base.h"
+#include <atomic>
+#include <thread>
+
+namespace xlang::text
+{
+    struct output_sink;
+}
 
 namespace xlang
 {
+    // The output sink that files written by the current thread are queued to. Generators that run in the same
+    // process each have their own sink, so a task inherits the sink of the thread that added it to a task_group.
+    inline text::output_sink*& current_output_sink() noexcept
+    {
+        thread_local text::output_sink* sink{};
+        return sink;
+    }
+
     struct task_group
     {
         task_group(task_group const&) = delete;
@@ -19,13 +34,51 @@ namespace xlang
             }
         }
 
+        // Tasks nest, such as a namespace's headers within the task for the namespace, and std::async may start a
+        // thread for each one. A task is therefore only started asynchronously while fewer than max_running() are
+        // running, and is otherwise run before add returns. Its exception is still reported by get.
         template <typename T>
         void add(T&& callback)
         {
 #if defined(XLANG_DEBUG)
-            callback();
+            run_inline(callback);
 #else
-            m_tasks.push_back(std::async(std::forward<T>(callback)));
+            if (running().fetch_add(1, std::memory_order_relaxed) >= max_running())
+            {
+                running().fetch_sub(1, std::memory_order_relaxed);
+                run_inline(callback);
+                return;
+            }
+
+            std::future<void> task;
+
+            try
+            {
+                // The sink is restored afterwards since std::async may run the task on a pooled thread.
+                task = std::async(std::launch::async, [sink = current_output_sink(), callback = std::forward<T>(callback)]() mutable
+                {
+                    struct task_scope
+                    {
+                        text::output_sink* previous;
+
+                        ~task_scope() noexcept
+                        {
+                            current_output_sink() = previous;
+                            running().fetch_sub(1, std::memory_order_relaxed);
+                        }
+                    };
+
+                    task_scope scope{ std::exchange(current_output_sink(), sink) };
+                    callback();
+                });
+            }
+            catch (...)
+            {
+                running().fetch_sub(1, std::memory_order_relaxed);
+                throw;
+            }
+
+            m_tasks.push_back(std::move(task));
 #endif
         }
 
@@ -46,6 +99,37 @@ namespace xlang
 
     private:
 
+        // Runs the task before returning, keeping its exception for get as an asynchronous task would.
+        template <typename T>
+        void run_inline(T& callback)
+        {
+            std::promise<void> result;
+
+            try
+            {
+                callback();
+                result.set_value();
+            }
+            catch (...)
+            {
+                result.set_exception(std::current_exception());
+            }
+
+            m_tasks.push_back(result.get_future());
+        }
+
+        static std::atomic<uint32_t>& running() noexcept
+        {
+            static std::atomic<uint32_t> count{};
+            return count;
+        }
+
+        static uint32_t max_running() noexcept
+        {
+            static uint32_t const count = (std::max)(std::thread::hardware_concurrency(), 2u) * 2;
+            return count;
+        }
+
         std::vector<std::future<void>> m_tasks;
     };
 }
@@ -1,6 +1,10 @@
 #pragma once
 
 #include "impl/base.h"
+#include "arena.h"
+#include "output_sink.h"
+#include "profiler.h"
+#include "task_group.h"
 
 namespace xlang::text
 {
@@ -29,22 +33,28 @@ namespace xlang::text
         template <typename... Args>
         std::string write_temp(std::string_view const& value, Args const&... args)
         {
-#if defined(XLANG_DEBUG)
-            bool restore_debug_trace = debug_trace;
-            debug_trace = false;
-#endif
-            auto const size = m_first.size();
-
-            XLANG_ASSERT(count_placeholders(value) == sizeof...(Args));
-            write_segment(value, args...);
+            return write_scratch([](std::string_view const& result)
+            {
+                return std::string{ result };
+            }, value, args...);
+        }
 
-            std::string result{ m_first.data() + size, m_first.size() - size };
-            m_first.resize(size);
+        // Like write_temp, but the result is kept in the writer's arena rather than a std::string. It remains valid
+        // for the lifetime of the writer.
+        template <typename... Args>
+        std::string_view write_transient(std::string_view const& value, Args const&... args)
+        {
+            return write_scratch([&](std::string_view const& result)
+            {
+                return m_arena.copy(result);
+            }, value, args...);
+        }
 
-#if defined(XLANG_DEBUG)
-            debug_trace = restore_debug_trace;
-#endif
-            return result;
+        // Transient state that dies with the writer, such as the containers a writer builds while writing a single
+        // type, may be allocated from the writer's arena.
+        arena& transient_arena() noexcept
+        {
+            return m_arena;
         }
 
         void write_impl(std::string_view const& value)
@@ -127,10 +137,82 @@ namespace xlang::text
         template <auto F, typename List, typename... Args>
         void write_each(List const& list, Args const&... args)
         {
+            profile_scope scope{ profiler::current() ? profile_name<F>() : std::string_view{} };
+            auto const size = m_first.size();
+
             for (auto&& item : list)
             {
                 F(*static_cast<T*>(this), item, args...);
             }
+
+            if (scope)
+            {
+                scope.bytes(m_first.size() - size);
+            }
+        }
+
+        // Like write_each, but a long list is split into fragments that are written in parallel, each by its own
+        // writer, and then appended in order so that the output matches write_each. The derived writer provides
+        // fork, to prepare a fragment's writer, and merge, to collect any state that the fragment's writer gathered.
+        template <auto F, typename List, typename... Args>
+        void write_each_parallel(List const& list, Args const&... args)
+        {
+            std::size_t const fragment_size = 16;
+            std::size_t const count = list.size();
+
+            if (count <= fragment_size)
+            {
+                write_each<F>(list, args...);
+                return;
+            }
+
+            profile_scope scope{ profiler::current() ? profile_name<F>() : std::string_view{} };
+            auto const size = m_first.size();
+            std::vector<T> fragments((count + fragment_size - 1) / fragment_size);
+            task_group group;
+
+            for (std::size_t index = 0; index != fragments.size(); ++index)
+            {
+                group.add([&, index]
+                {
+                    auto& fragment = fragments[index];
+                    static_cast<T const*>(this)->fork(fragment);
+                    auto first = list.begin() + index * fragment_size;
+                    auto last = first + (std::min)(fragment_size, count - index * fragment_size);
+
+                    for (; first != last; ++first)
+                    {
+                        F(fragment, *first, args...);
+                    }
+                });
+            }
+
+            group.get();
+
+            for (auto&& fragment : fragments)
+            {
+                XLANG_ASSERT(fragment.m_second.empty());
+                m_first.insert(m_first.end(), fragment.m_first.begin(), fragment.m_first.end());
+                static_cast<T*>(this)->merge(fragment);
+            }
+
+            if (scope)
+            {
+                scope.bytes(m_first.size() - size);
+            }
+        }
+
+        template <auto F, typename... Args>
+        void write_profiled(Args const&... args)
+        {
+            profile_scope scope{ profiler::current() ? profile_name<F>() : std::string_view{} };
+            auto const size = m_first.size();
+            F(*static_cast<T*>(this), args...);
+
+            if (scope)
+            {
+                scope.bytes(m_first.size() - size);
+            }
         }
 
         void swap() noexcept
@@ -148,11 +230,15 @@ namespace xlang::text
 
         void flush_to_file(std::string const& filename)
         {
-            if (!file_equal(filename))
+            profiler::bytes_written() += m_first.size() + m_second.size();
+
+            if (auto sink = output_sink::current())
+            {
+                sink->write(filename, std::move(m_first), std::move(m_second));
+            }
+            else
             {
-                std::ofstream file{ filename, std::ios::out | std::ios::binary };
-                file.write(m_first.data(), m_first.size());
-                file.write(m_second.data(), m_second.size());
+                output_sink::write_file(filename, m_first, m_second);
             }
             m_first.clear();
             m_second.clear();
@@ -181,24 +267,7 @@ namespace xlang::text
 
         bool file_equal(std::string const& filename) const
         {
-            if (!std::filesystem::exists(filename))
-            {
-                return false;
-            }
-
-            meta::reader::file_view file{ filename };
-
-            if (file.size() != m_first.size() + m_second.size())
-            {
-                return false;
-            }
-
-            if (!std::equal(m_first.begin(), m_first.end(), file.begin(), file.begin() + m_first.size()))
-            {
-                return false;
-            }
-
-            return std::equal(m_second.begin(), m_second.end(), file.begin() + m_first.size(), file.end());
+            return output_sink::file_equal(filename, m_first, m_second);
         }
 
 #if defined(XLANG_DEBUG)
@@ -207,6 +276,27 @@ namespace xlang::text
 
     private:
 
+        template <typename Copy, typename... Args>
+        auto write_scratch(Copy const& copy, std::string_view const& value, Args const&... args)
+        {
+#if defined(XLANG_DEBUG)
+            bool restore_debug_trace = debug_trace;
+            debug_trace = false;
+#endif
+            auto const size = m_first.size();
+
+            XLANG_ASSERT(count_placeholders(value) == sizeof...(Args));
+            write_segment(value, args...);
+
+            auto result = copy(std::string_view{ m_first.data() + size, m_first.size() - size });
+            m_first.resize(size);
+
+#if defined(XLANG_DEBUG)
+            debug_trace = restore_debug_trace;
+#endif
+            return result;
+        }
+
         static constexpr uint32_t count_placeholders(std::string_view const& format) noexcept
         {
             uint32_t count{};
@@ -288,6 +378,7 @@ namespace xlang::text
 
         std::vector<char> m_second;
         std::vector<char> m_first;
+        arena m_arena;
     };
 
 
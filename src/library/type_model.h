@@ -0,0 +1,386 @@
+#pragma once
+
+#include "meta_reader.h"
+#include "profiler.h"
+#include "task_group.h"
+#include <atomic>
+#include <memory>
+#include <mutex>
+
+namespace xlang::meta::reader
+{
+    // The analysis of each type that the projection generators have in common: base classes, the default
+    // interface, and the complete set of interfaces that a type requires. The model is computed once, in parallel,
+    // so that it can be shared by generators that run over the same metadata.
+    // Generic interfaces are recorded by their definitions since substituting generic arguments is specific to
+    // each projection. The model also holds the decoded signature of each method that a generator looks up, which
+    // each generator otherwise decodes again in every writer that visits the method.
+
+    struct type_model
+    {
+        type_model(type_model const&) = delete;
+        type_model& operator=(type_model const&) = delete;
+
+        struct type_info
+        {
+            TypeDef type;
+
+            // Nearest base class first
+            std::vector<TypeDef> bases;
+
+            // Index of the default interface within the type's InterfaceImpl range
+            std::optional<uint32_t> default_interface;
+
+            // The interfaces required directly or indirectly by this type, not including those required by its
+            // base classes
+            std::vector<TypeDef> required_interfaces;
+        };
+
+        struct method_info
+        {
+            MethodDefSig signature;
+
+            // The Param row naming the return value, if any, and the Param row of the first parameter
+            Param return_param;
+            Param first_param;
+        };
+
+        explicit type_model(cache const& c) : m_cache(&c)
+        {
+            profile_scope profile{ "type_model" };
+            index(c);
+            std::vector<std::vector<TypeDef>> direct(m_types.size());
+
+            for_each_chunk([&](std::size_t first, std::size_t last)
+            {
+                for (auto i = first; i != last; ++i)
+                {
+                    analyze(m_types[i], direct[i]);
+                }
+            });
+
+            // The transitive closures only read the direct requirements, so they may be computed in parallel once
+            // all of those are known.
+            for_each_chunk([&](std::size_t first, std::size_t last)
+            {
+                for (auto i = first; i != last; ++i)
+                {
+                    close(direct, i);
+                }
+            });
+
+            index_methods(c);
+            publish();
+        }
+
+        ~type_model() noexcept
+        {
+            for (auto slot = registry().load(std::memory_order_acquire); slot; slot = slot->next)
+            {
+                type_model const* expected = this;
+
+                if (slot->model.compare_exchange_strong(expected, nullptr))
+                {
+                    break;
+                }
+            }
+        }
+
+        // The model built for the cache, if any. Generators running in the same process may each have a model for
+        // a different cache, so models are published per cache. Lookups only read the registry so that they are
+        // cheap enough for the helpers that consult the model.
+        static type_model const* current(cache const& c) noexcept
+        {
+            for (auto slot = registry().load(std::memory_order_acquire); slot; slot = slot->next)
+            {
+                auto model = slot->model.load(std::memory_order_acquire);
+
+                if (model && model->m_cache == &c)
+                {
+                    return model;
+                }
+            }
+
+            return nullptr;
+        }
+
+        static type_model const* current(TypeDef const& type) noexcept
+        {
+            return current(type.get_cache());
+        }
+
+        type_info const* find(TypeDef const& type) const noexcept
+        {
+            auto found = std::lower_bound(m_types.begin(), m_types.end(), type, [](type_info const& info, TypeDef const& type)
+            {
+                return info.type < type;
+            });
+
+            if (found == m_types.end() || found->type != type)
+            {
+                return nullptr;
+            }
+
+            return &*found;
+        }
+
+        // The method's chunk is decoded on first use, so a generator that only writes a few namespaces does not pay
+        // for decoding every method in the cache.
+        method_info const* find(MethodDef const& method) const
+        {
+            for (auto&& methods : m_methods)
+            {
+                if (methods.db == &method.get_database())
+                {
+                    auto const index = method.index();
+                    auto& chunk = methods.chunks[index / chunk_size];
+
+                    std::call_once(chunk.decoded, [&]
+                    {
+                        decode_chunk(*methods.db, index / chunk_size, chunk.methods);
+                    });
+
+                    return &chunk.methods[index % chunk_size];
+                }
+            }
+
+            return nullptr;
+        }
+
+        static method_info decode(MethodDef const& method)
+        {
+            method_info info{ method.Signature() };
+            auto params = method.ParamList();
+
+            if (info.signature.ReturnType() && params.first != params.second && params.first.Sequence() == 0)
+            {
+                info.return_param = params.first;
+                ++params.first;
+            }
+
+            info.first_param = params.first;
+            return info;
+        }
+
+        static coded_index<TypeDefOrRef> get_default_interface(type_info const& info)
+        {
+            if (!info.default_interface)
+            {
+                return {};
+            }
+
+            return (info.type.InterfaceImpl().first + *info.default_interface).Interface();
+        }
+
+        // True if the type is, or requires, the named interface. Like the generators' own helpers, this does not
+        // consider the interfaces of base classes.
+        bool implements(TypeDef const& type, std::string_view const& type_namespace, std::string_view const& type_name) const
+        {
+            auto matches = [&](TypeDef const& candidate)
+            {
+                return candidate.TypeName() == type_name && candidate.TypeNamespace() == type_namespace;
+            };
+
+            if (get_category(type) == category::interface_type && matches(type))
+            {
+                return true;
+            }
+
+            auto info = find(type);
+
+            if (!info)
+            {
+                return false;
+            }
+
+            return std::any_of(info->required_interfaces.begin(), info->required_interfaces.end(), matches);
+        }
+
+    private:
+
+        static constexpr std::size_t chunk_size = 256;
+
+        // Each database's methods, indexed by MethodDef row and decoded in chunks. The chunks are never resized once
+        // decoded so that signatures and the parameters within them have stable addresses.
+        struct method_chunk
+        {
+            std::once_flag decoded;
+            std::vector<method_info> methods;
+        };
+
+        struct method_table
+        {
+            database const* db;
+            std::unique_ptr<method_chunk[]> chunks;
+        };
+
+        // The registry is a list of slots that only grows. A slot is reused once its model is destroyed, and is never
+        // freed, so that lookups need not lock.
+        struct registry_slot
+        {
+            std::atomic<type_model const*> model;
+            registry_slot* next;
+        };
+
+        static std::atomic<registry_slot*>& registry() noexcept
+        {
+            static std::atomic<registry_slot*> head{};
+            return head;
+        }
+
+        void publish()
+        {
+            for (auto slot = registry().load(std::memory_order_acquire); slot; slot = slot->next)
+            {
+                type_model const* expected{};
+
+                if (slot->model.compare_exchange_strong(expected, this, std::memory_order_release))
+                {
+                    return;
+                }
+            }
+
+            auto slot = new registry_slot{ { this }, registry().load(std::memory_order_relaxed) };
+
+            while (!registry().compare_exchange_weak(slot->next, slot, std::memory_order_release, std::memory_order_relaxed))
+            {
+            }
+        }
+
+        void index(cache const& c)
+        {
+            for (auto&&[ns, members] : c.namespaces())
+            {
+                for (auto&&[name, type] : members.types)
+                {
+                    m_types.push_back({ type });
+                }
+            }
+
+            std::sort(m_types.begin(), m_types.end(), [](type_info const& left, type_info const& right)
+            {
+                return left.type < right.type;
+            });
+        }
+
+        template <typename F>
+        void for_each_chunk(F const& callback)
+        {
+            task_group group;
+
+            for (std::size_t first = 0; first < m_types.size(); first += chunk_size)
+            {
+                group.add([&, first]
+                {
+                    callback(first, (std::min)(first + chunk_size, m_types.size()));
+                });
+            }
+
+            group.get();
+        }
+
+        void index_methods(cache const& c)
+        {
+            for (auto&& db : c.databases())
+            {
+                m_methods.push_back({ &db, std::make_unique<method_chunk[]>((db.MethodDef.size() + chunk_size - 1) / chunk_size) });
+            }
+        }
+
+        static void decode_chunk(database const& db, std::size_t chunk, std::vector<method_info>& target)
+        {
+            auto first = static_cast<uint32_t>(chunk * chunk_size);
+            auto last = (std::min)(first + static_cast<uint32_t>(chunk_size), db.MethodDef.size());
+            target.reserve(last - first);
+
+            for (auto row = first; row != last; ++row)
+            {
+                target.push_back(decode(db.MethodDef[row]));
+            }
+        }
+
+        static TypeDef get_base_class(TypeDef const& type)
+        {
+            auto extends = type.Extends();
+
+            if (!extends)
+            {
+                return {};
+            }
+
+            auto const&[extends_namespace, extends_name] = get_type_namespace_and_name(extends);
+
+            if (extends_name == "Object" && extends_namespace == "System")
+            {
+                return {};
+            }
+
+            return find_required(extends);
+        }
+
+        static TypeDef get_interface(coded_index<TypeDefOrRef> const& type)
+        {
+            if (type.type() == TypeDefOrRef::TypeSpec)
+            {
+                return find_required(type.TypeSpec().Signature().GenericTypeInst().GenericType());
+            }
+
+            return find_required(type);
+        }
+
+        static void analyze(type_info& info, std::vector<TypeDef>& direct)
+        {
+            if (get_category(info.type) == category::class_type)
+            {
+                for (auto base = get_base_class(info.type); base; base = get_base_class(base))
+                {
+                    info.bases.push_back(base);
+                }
+            }
+
+            uint32_t index{};
+
+            for (auto&& impl : info.type.InterfaceImpl())
+            {
+                if (!info.default_interface && get_attribute(impl, "Windows.Foundation.Metadata", "DefaultAttribute"))
+                {
+                    info.default_interface = index;
+                }
+
+                direct.push_back(get_interface(impl.Interface()));
+                ++index;
+            }
+        }
+
+        void close(std::vector<std::vector<TypeDef>> const& direct, std::size_t index)
+        {
+            auto& result = m_types[index].required_interfaces;
+            std::vector<TypeDef> pending = direct[index];
+
+            while (!pending.empty())
+            {
+                auto type = pending.back();
+                pending.pop_back();
+
+                if (std::find(result.begin(), result.end(), type) != result.end())
+                {
+                    continue;
+                }
+
+                result.push_back(type);
+
+                if (auto info = find(type))
+                {
+                    auto const& next = direct[info - m_types.data()];
+                    pending.insert(pending.end(), next.begin(), next.end());
+                }
+            }
+
+            std::sort(result.begin(), result.end());
+        }
+
+        cache const* m_cache;
+        std::vector<type_info> m_types;
+        std::vector<method_table> m_methods;
+    };
+}
@@ -1,26 +1,307 @@
 #include "pal_internal.h"
 #include "opaque_string_wrapper.h"
+#include "activation_manifest.h"
+#include "pal_statistics.h"
 #include "platform_activation.h"
 #include "pal_error.h"
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <shared_mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
 
 namespace xlang::impl
 {
+    // Resolving a class loads a module for each of its enclosing namespaces in turn, so the results are cached: the
+    // activation function exported for each namespace (or its absence), the function that resolved each class (or
+    // the fact that none did), and the factory returned for each class and interface. Cached factories hold a
+    // reference until the cache is cleared. Caching is best effort, so running out of memory while updating the
+    // cache never fails an activation.
+    template <typename char_type>
+    struct activation_cache
+    {
+        using view_type = std::basic_string_view<char_type>;
+
+        static activation_cache& get()
+        {
+            // Deliberately leaked, since releasing the factories while static objects are destroyed could call
+            // into modules that have already been unloaded.
+            static activation_cache* value = new activation_cache;
+            return *value;
+        }
+
+        // Returns a new reference to the cached factory for the class and interface, if there is one.
+        bool find_factory(view_type class_name, xlang_guid const& iid, void** factory)
+        {
+            std::shared_lock<std::shared_mutex> guard{ m_lock };
+            auto found = m_classes.find(class_name);
+
+            if (found == m_classes.end())
+            {
+                return false;
+            }
+
+            for (auto&& [factory_iid, value] : found->second->factories)
+            {
+                if (factory_iid == iid)
+                {
+                    value->AddRef();
+                    *factory = value;
+                    return true;
+                }
+            }
+
+            return false;
+        }
+
+        // Returns the activation function that resolved the class, nullptr if none did, or nullopt if the class
+        // has not been resolved yet.
+        std::optional<xlang_pfn_lib_get_activation_factory> find_class(view_type class_name)
+        {
+            std::shared_lock<std::shared_mutex> guard{ m_lock };
+            auto found = m_classes.find(class_name);
+
+            if (found == m_classes.end())
+            {
+                return std::nullopt;
+            }
+
+            return found->second->pfn;
+        }
+
+        xlang_pfn_lib_get_activation_factory get_activation_func(view_type module_namespace)
+        {
+            {
+                std::shared_lock<std::shared_mutex> guard{ m_lock };
+                auto found = m_modules.find(module_namespace);
+
+                if (found != m_modules.end())
+                {
+                    return found->second->pfn;
+                }
+            }
+
+            // The module is loaded without holding the lock, since loading it may run code that activates classes.
+            xlang_pfn_lib_get_activation_factory pfn = try_get_activation_func(module_namespace);
+            count(&pal_counters::activation_module_probes);
+            std::unique_lock<std::shared_mutex> guard{ m_lock };
+            insert(m_modules, module_namespace, pfn);
+            return pfn;
+        }
+
+        void add_class(view_type class_name, xlang_pfn_lib_get_activation_factory pfn)
+        {
+            std::unique_lock<std::shared_mutex> guard{ m_lock };
+            insert(m_classes, class_name, pfn);
+        }
+
+        void add_factory(view_type class_name, xlang_pfn_lib_get_activation_factory pfn, xlang_guid const& iid, void* factory)
+        {
+            std::unique_lock<std::shared_mutex> guard{ m_lock };
+            auto target = insert(m_classes, class_name, pfn);
+
+            if (!target)
+            {
+                return;
+            }
+
+            for (auto&& [factory_iid, value] : target->factories)
+            {
+                if (factory_iid == iid)
+                {
+                    return;
+                }
+            }
+
+            try
+            {
+                target->factories.emplace_back(iid, static_cast<xlang_unknown*>(factory));
+                target->factories.back().second->AddRef();
+            }
+            catch (std::bad_alloc const&)
+            {
+            }
+        }
+
+    private:
+
+        // The maps' keys refer to the names held by their entries, which are allocated separately so that the
+        // names never move.
+        struct entry
+        {
+            std::basic_string<char_type> name;
+            xlang_pfn_lib_get_activation_factory pfn{};
+            std::vector<std::pair<xlang_guid, xlang_unknown*>> factories;
+        };
+
+        using map_type = std::unordered_map<view_type, std::unique_ptr<entry>>;
+
+    public:
+
+        // The classes removed from the cache. Their factories are released when this is destroyed, which the
+        // caller can defer until it no longer holds any locks, since releasing them may run arbitrary code.
+        struct detached_classes
+        {
+            map_type classes;
+
+            detached_classes() noexcept = default;
+
+            detached_classes(detached_classes&& other) noexcept
+            {
+                classes.swap(other.classes);
+            }
+
+            detached_classes& operator=(detached_classes const&) = delete;
+
+            ~detached_classes() noexcept
+            {
+                for (auto&& [class_name, target] : classes)
+                {
+                    for (auto&& [iid, value] : target->factories)
+                    {
+                        value->Release();
+                    }
+                }
+            }
+        };
+
+        detached_classes detach() noexcept
+        {
+            detached_classes result;
+            std::unique_lock<std::shared_mutex> guard{ m_lock };
+            m_modules.clear();
+            result.classes.swap(m_classes);
+            return result;
+        }
+
+    private:
+
+        static entry* insert(map_type& map, view_type name, xlang_pfn_lib_get_activation_factory pfn) noexcept
+        {
+            auto found = map.find(name);
+
+            if (found != map.end())
+            {
+                return found->second.get();
+            }
+
+            try
+            {
+                auto value = std::make_unique<entry>();
+                value->name = name;
+                value->pfn = pfn;
+                view_type const key{ value->name };
+                return map.emplace(key, std::move(value)).first->second.get();
+            }
+            catch (std::bad_alloc const&)
+            {
+                return nullptr;
+            }
+        }
+
+        std::shared_mutex m_lock;
+        map_type m_modules;
+        map_type m_classes;
+    };
+
+    // Empties every activation cache. When the filesystem's character type matches one of the others, its cache is
+    // the same one, and is simply found empty the second time.
+    struct detached_activation_cache
+    {
+        activation_cache<xlang_char8>::detached_classes utf8{ activation_cache<xlang_char8>::get().detach() };
+        activation_cache<char16_t>::detached_classes utf16{ activation_cache<char16_t>::get().detach() };
+        activation_cache<filesystem_char_type>::detached_classes filesystem{ activation_cache<filesystem_char_type>::get().detach() };
+    };
+
+    void clear_activation_cache() noexcept
+    {
+        detached_activation_cache detached;
+    }
+
     template <typename char_type>
     xlang_error_info* get_activation_factory(
         xlang_string class_name,
         xlang_guid const& iid,
         void** factory)
     {
-        for (auto current_namespace = enclosing_namespace(to_string_view<char_type>(class_name));
+        auto& cache = activation_cache<char_type>::get();
+        auto const name = to_string_view<char_type>(class_name);
+
+        if (cache.find_factory(name, iid, factory))
+        {
+            count(&pal_counters::activation_cache_hits);
+            return nullptr;
+        }
+
+        // Counts the activation as a miss once it calls an activation function, however many it tries.
+        bool called{};
+        auto activate = [&](xlang_pfn_lib_get_activation_factory pfn)
+        {
+            if (!called)
+            {
+                called = true;
+                count(&pal_counters::activation_cache_misses);
+            }
+
+            return (*pfn)(class_name, iid, factory);
+        };
+
+        if (auto const known = cache.find_class(name))
+        {
+            if (!*known)
+            {
+                return xlang_originate_error(xlang_result::type_load);
+            }
+
+            xlang_result result = activate(*known);
+            if (result != xlang_result::success)
+            {
+                throw_result(result);
+            }
+
+            cache.add_factory(name, *known, iid, *factory);
+            return nullptr;
+        }
+
+        // A class listed in the manifest is only looked for in the library that the manifest names.
+        if (auto const manifest = activation_manifest::current())
+        {
+            auto const target = manifest->find(name);
+
+            if (target || manifest->is_exclusive())
+            {
+                if (xlang_pfn_lib_get_activation_factory pfn = target ? manifest->get_activation_func(*target) : nullptr)
+                {
+                    xlang_result result = activate(pfn);
+                    if (result == xlang_result::success)
+                    {
+                        cache.add_factory(name, pfn, iid, *factory);
+                        return nullptr;
+                    }
+                    else if (result != xlang_result::type_load)
+                    {
+                        throw_result(result);
+                    }
+                }
+
+                cache.add_class(name, nullptr);
+                return xlang_originate_error(xlang_result::type_load);
+            }
+        }
+
+        for (auto current_namespace = enclosing_namespace(name);
             !current_namespace.empty();
             current_namespace = enclosing_namespace(current_namespace))
         {
-            xlang_pfn_lib_get_activation_factory pfn = try_get_activation_func(current_namespace);
+            xlang_pfn_lib_get_activation_factory pfn = cache.get_activation_func(current_namespace);
             if (pfn)
             {
-                xlang_result result = (*pfn)(class_name, iid, factory);
+                xlang_result result = activate(pfn);
                 if (result == xlang_result::success)
                 {
+                    cache.add_factory(name, pfn, iid, *factory);
                     return nullptr;
                 }
                 else if (result != xlang_result::type_load)
@@ -29,6 +310,8 @@ namespace xlang::impl
                 }
             }
         }
+
+        cache.add_class(name, nullptr);
         return xlang_originate_error(xlang_result::type_load);
     }
 }
@@ -65,4 +348,31 @@ catch (...)
 {
     *factory = nullptr;
     return xlang::to_result();
-}
\ No newline at end of file
+}
+
+XLANG_PAL_EXPORT void XLANG_CALL xlang_clear_activation_factory_cache() XLANG_NOEXCEPT
+{
+    clear_activation_cache();
+}
+
+XLANG_PAL_EXPORT xlang_error_info* XLANG_CALL xlang_load_activation_manifest(
+    xlang_string path,
+    xlang_activation_manifest_options options
+) noexcept
+try
+{
+    // Classes that the previous manifest, or probing, resolved may now be found elsewhere, so the cache is emptied
+    // as the manifest is replaced. The factories it held are released once the manifest's lock is.
+    std::optional<detached_activation_cache> detached;
+
+    activation_manifest::load(path ? to_string_view<xlang_char8>(path) : std::basic_string_view<xlang_char8>{}, options, [&]
+    {
+        detached.emplace();
+    });
+
+    return nullptr;
+}
+catch (...)
+{
+    return xlang::to_result();
+}
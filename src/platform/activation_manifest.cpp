@@ -0,0 +1,478 @@
+#include "pal_internal.h"
+#include "activation_manifest.h"
+#include "platform_activation.h"
+#include "string_convert.h"
+#include "pal_error.h"
+#include "pal_statistics.h"
+#include <stdlib.h>
+#include <shared_mutex>
+
+namespace xlang::impl
+{
+    namespace
+    {
+        [[noreturn]] void throw_invalid_manifest()
+        {
+            throw_result(xlang_result::invalid_arg, "Invalid activation manifest");
+        }
+
+        // Parses the subset of JSON that a manifest uses: a single object whose members are all strings.
+        struct manifest_parser
+        {
+            std::basic_string_view<xlang_char8> remaining;
+
+            void skip_whitespace() noexcept
+            {
+                while (!remaining.empty() &&
+                    (remaining[0] == ' ' || remaining[0] == '\t' || remaining[0] == '\n' || remaining[0] == '\r'))
+                {
+                    remaining.remove_prefix(1);
+                }
+            }
+
+            // Skips whitespace, and then the given character if it is next.
+            bool try_consume(xlang_char8 value) noexcept
+            {
+                skip_whitespace();
+
+                if (!remaining.empty() && remaining[0] == value)
+                {
+                    remaining.remove_prefix(1);
+                    return true;
+                }
+
+                return false;
+            }
+
+            void consume(xlang_char8 value)
+            {
+                if (!try_consume(value))
+                {
+                    throw_invalid_manifest();
+                }
+            }
+
+            xlang_char8 next()
+            {
+                if (remaining.empty())
+                {
+                    throw_invalid_manifest();
+                }
+
+                xlang_char8 result = remaining[0];
+                remaining.remove_prefix(1);
+                return result;
+            }
+
+            uint32_t read_hex4()
+            {
+                uint32_t result{};
+
+                for (int i = 0; i < 4; ++i)
+                {
+                    auto const c = next();
+                    result <<= 4;
+
+                    if (c >= '0' && c <= '9')
+                    {
+                        result |= c - '0';
+                    }
+                    else if (c >= 'a' && c <= 'f')
+                    {
+                        result |= c - 'a' + 10;
+                    }
+                    else if (c >= 'A' && c <= 'F')
+                    {
+                        result |= c - 'A' + 10;
+                    }
+                    else
+                    {
+                        throw_invalid_manifest();
+                    }
+                }
+
+                return result;
+            }
+
+            static void append_utf8(std::basic_string<xlang_char8>& result, uint32_t code_point)
+            {
+                if (code_point < 0x80)
+                {
+                    result += static_cast<xlang_char8>(code_point);
+                }
+                else if (code_point < 0x800)
+                {
+                    result += static_cast<xlang_char8>(0xC0 | (code_point >> 6));
+                    result += static_cast<xlang_char8>(0x80 | (code_point & 0x3F));
+                }
+                else if (code_point < 0x10000)
+                {
+                    result += static_cast<xlang_char8>(0xE0 | (code_point >> 12));
+                    result += static_cast<xlang_char8>(0x80 | ((code_point >> 6) & 0x3F));
+                    result += static_cast<xlang_char8>(0x80 | (code_point & 0x3F));
+                }
+                else
+                {
+                    result += static_cast<xlang_char8>(0xF0 | (code_point >> 18));
+                    result += static_cast<xlang_char8>(0x80 | ((code_point >> 12) & 0x3F));
+                    result += static_cast<xlang_char8>(0x80 | ((code_point >> 6) & 0x3F));
+                    result += static_cast<xlang_char8>(0x80 | (code_point & 0x3F));
+                }
+            }
+
+            uint32_t read_escaped_code_point()
+            {
+                auto result = read_hex4();
+
+                if (result >= 0xDC00 && result <= 0xDFFF)
+                {
+                    throw_invalid_manifest();
+                }
+
+                if (result >= 0xD800 && result <= 0xDBFF)
+                {
+                    if (next() != '\\' || next() != 'u')
+                    {
+                        throw_invalid_manifest();
+                    }
+
+                    auto const low = read_hex4();
+
+                    if (low < 0xDC00 || low > 0xDFFF)
+                    {
+                        throw_invalid_manifest();
+                    }
+
+                    result = 0x10000 + ((result - 0xD800) << 10) + (low - 0xDC00);
+                }
+
+                return result;
+            }
+
+            // Unescaped characters are copied as they are, so any invalid UTF-8 is caught when the class names are
+            // converted to UTF-16.
+            std::basic_string<xlang_char8> read_string()
+            {
+                consume('"');
+                std::basic_string<xlang_char8> result;
+
+                while (true)
+                {
+                    auto const c = next();
+
+                    if (c == '"')
+                    {
+                        return result;
+                    }
+
+                    if (static_cast<unsigned char>(c) < 0x20)
+                    {
+                        throw_invalid_manifest();
+                    }
+
+                    if (c != '\\')
+                    {
+                        result += c;
+                        continue;
+                    }
+
+                    switch (next())
+                    {
+                    case '"': result += '"'; break;
+                    case '\\': result += '\\'; break;
+                    case '/': result += '/'; break;
+                    case 'b': result += '\b'; break;
+                    case 'f': result += '\f'; break;
+                    case 'n': result += '\n'; break;
+                    case 'r': result += '\r'; break;
+                    case 't': result += '\t'; break;
+                    case 'u': append_utf8(result, read_escaped_code_point()); break;
+                    default: throw_invalid_manifest();
+                    }
+                }
+            }
+        };
+
+        bool is_separator(xlang_char8 value) noexcept
+        {
+#if XLANG_PLATFORM_WINDOWS
+            return value == '/' || value == '\\';
+#else
+            return value == '/';
+#endif
+        }
+
+        // Returns the directory holding the file, with its trailing separator, or nothing if the path has no
+        // directory.
+        std::basic_string_view<xlang_char8> get_directory(std::basic_string_view<xlang_char8> path) noexcept
+        {
+            auto length = path.size();
+
+            while (length != 0 && !is_separator(path[length - 1]))
+            {
+                --length;
+            }
+
+            return path.substr(0, length);
+        }
+
+        // Bare file names are left to the loader's search, and absolute paths are used as they are.
+        bool is_relative_to_directory(std::basic_string_view<xlang_char8> path) noexcept
+        {
+            if (is_separator(path[0]))
+            {
+                return false;
+            }
+
+#if XLANG_PLATFORM_WINDOWS
+            if (path.size() > 1 && path[1] == ':')
+            {
+                return false;
+            }
+#endif
+
+            for (auto c : path)
+            {
+                if (is_separator(c))
+                {
+                    return true;
+                }
+            }
+
+            return false;
+        }
+
+        xlang_activation_manifest_options get_options_from_environment()
+        {
+            auto result = xlang_activation_manifest_options::none;
+            auto value = ::getenv("XLANG_PAL_ACTIVATION_MANIFEST_OPTIONS");
+
+            if (!value)
+            {
+                return result;
+            }
+
+            std::string_view remaining{ value };
+
+            while (!remaining.empty())
+            {
+                auto const length = remaining.find(',');
+                auto const name = remaining.substr(0, length);
+                remaining.remove_prefix(length == remaining.npos ? remaining.size() : length + 1);
+
+                if (name == "preload")
+                {
+                    result = result | xlang_activation_manifest_options::preload;
+                }
+                else if (name == "bind_now")
+                {
+                    result = result | xlang_activation_manifest_options::bind_now;
+                }
+                else if (name == "exclusive")
+                {
+                    result = result | xlang_activation_manifest_options::exclusive;
+                }
+                else if (!name.empty())
+                {
+                    throw_result(xlang_result::invalid_arg, "Invalid activation manifest options");
+                }
+            }
+
+            return result;
+        }
+
+        struct manifest_state
+        {
+            std::shared_mutex lock;
+            bool initialized{};
+            std::shared_ptr<activation_manifest const> current;
+
+            // Deliberately leaked, since the libraries that the manifest loaded are never unloaded either.
+            static manifest_state& get()
+            {
+                static manifest_state* value = new manifest_state;
+                return *value;
+            }
+        };
+    }
+
+    activation_manifest::activation_manifest(
+        std::basic_string_view<xlang_char8> contents,
+        std::basic_string_view<xlang_char8> directory,
+        xlang_activation_manifest_options options) :
+        m_options(options)
+    {
+        parse(contents, directory);
+        index();
+
+        if ((options & xlang_activation_manifest_options::preload) != xlang_activation_manifest_options::none)
+        {
+            for (auto&& target : m_libraries)
+            {
+                if (!get_activation_func(*target))
+                {
+                    throw_result(xlang_result::type_load, "Unable to load a library listed in the activation manifest");
+                }
+            }
+        }
+    }
+
+    void activation_manifest::parse(std::basic_string_view<xlang_char8> contents, std::basic_string_view<xlang_char8> directory)
+    {
+        manifest_parser parser{ contents };
+
+        // The keys refer to the paths held by m_libraries, whose entries are allocated separately so that the
+        // paths never move.
+        std::unordered_map<std::basic_string_view<xlang_char8>, library*> libraries;
+        parser.consume('{');
+
+        if (!parser.try_consume('}'))
+        {
+            do
+            {
+                parser.skip_whitespace();
+                auto class_name = parser.read_string();
+                parser.consume(':');
+                parser.skip_whitespace();
+                auto path = parser.read_string();
+
+                if (class_name.empty() || path.empty())
+                {
+                    throw_invalid_manifest();
+                }
+
+                if (is_relative_to_directory(path))
+                {
+                    path.insert(0, directory);
+                }
+
+                auto found = libraries.find(path);
+                library* target{};
+
+                if (found != libraries.end())
+                {
+                    target = found->second;
+                }
+                else
+                {
+                    m_libraries.push_back(std::make_unique<library>());
+                    target = m_libraries.back().get();
+                    target->path = std::move(path);
+                    libraries.emplace(target->path, target);
+                }
+
+                m_classes.push_back({ std::move(class_name), {}, target });
+            }
+            while (parser.try_consume(','));
+
+            parser.consume('}');
+        }
+
+        parser.skip_whitespace();
+
+        if (!parser.remaining.empty())
+        {
+            throw_invalid_manifest();
+        }
+    }
+
+    void activation_manifest::index()
+    {
+        m_utf8_classes.reserve(m_classes.size());
+        m_utf16_classes.reserve(m_classes.size());
+
+        for (auto&& entry : m_classes)
+        {
+            auto const length = get_converted_length(std::basic_string_view<xlang_char8>{ entry.utf8_name });
+            entry.utf16_name.resize(length);
+            convert_string(std::basic_string_view<xlang_char8>{ entry.utf8_name }, entry.utf16_name.data(), length);
+
+            if (!m_utf8_classes.emplace(entry.utf8_name, entry.target).second)
+            {
+                throw_result(xlang_result::invalid_arg, "Activation manifest lists a class more than once");
+            }
+
+            m_utf16_classes.emplace(entry.utf16_name, entry.target);
+        }
+    }
+
+    xlang_pfn_lib_get_activation_factory activation_manifest::get_activation_func(library const& target) const
+    {
+        auto const bind_now = (m_options & xlang_activation_manifest_options::bind_now) != xlang_activation_manifest_options::none;
+
+        std::call_once(target.loaded, [&]
+        {
+            target.pfn = try_load_activation_func(target.path, bind_now);
+            count(&pal_counters::activation_module_probes);
+        });
+
+        return target.pfn;
+    }
+
+    std::shared_ptr<activation_manifest const> activation_manifest::current()
+    {
+        auto& state = manifest_state::get();
+
+        {
+            std::shared_lock<std::shared_mutex> guard{ state.lock };
+
+            if (state.initialized)
+            {
+                return state.current;
+            }
+        }
+
+        // The manifest is opened without holding the lock, since preloading its libraries may run code that
+        // activates classes. If another thread gets there first, its manifest is used instead.
+        std::shared_ptr<activation_manifest const> manifest;
+
+        if (auto path = ::getenv("XLANG_PAL_ACTIVATION_MANIFEST"); path && *path)
+        {
+            try
+            {
+                manifest = open(reinterpret_cast<xlang_char8 const*>(path), get_options_from_environment());
+            }
+            catch (...)
+            {
+                // The error is only reported once, rather than reading the manifest again on every activation.
+                std::unique_lock<std::shared_mutex> guard{ state.lock };
+                state.initialized = true;
+                throw;
+            }
+        }
+
+        std::unique_lock<std::shared_mutex> guard{ state.lock };
+
+        if (!state.initialized)
+        {
+            swap(manifest);
+        }
+
+        return state.current;
+    }
+
+    std::shared_ptr<activation_manifest const> activation_manifest::open(
+        std::basic_string_view<xlang_char8> path,
+        xlang_activation_manifest_options options)
+    {
+        if (path.empty())
+        {
+            return nullptr;
+        }
+
+        mapped_file file{ path };
+        return std::make_shared<activation_manifest const>(file.data(), get_directory(path), options);
+    }
+
+    std::shared_mutex& activation_manifest::get_lock() noexcept
+    {
+        return manifest_state::get().lock;
+    }
+
+    void activation_manifest::swap(std::shared_ptr<activation_manifest const>& manifest) noexcept
+    {
+        auto& state = manifest_state::get();
+        state.current.swap(manifest);
+        state.initialized = true;
+    }
+}
@@ -0,0 +1,127 @@
+#pragma once
+
+#include "pal.h"
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+namespace xlang::impl
+{
+    // An activation manifest maps runtime class names directly to the libraries that implement them, so that
+    // activating a listed class loads a single library rather than probing one for each enclosing namespace. It
+    // also allows a class to live in a library whose name is unrelated to its namespace.
+    //
+    // The manifest is a JSON object whose members map class names to library paths:
+    //
+    //     { "Contoso.Widget": "libcontoso.so", "Contoso.Gadget": "../lib/libgadgets.so" }
+    //
+    // A relative path that names a directory is relative to the directory holding the manifest. A bare file name is
+    // passed to the platform's loader as written, so that the loader's usual search applies.
+    //
+    // A manifest is loaded by xlang_load_activation_manifest or, when that has not been called, from the path in
+    // the XLANG_PAL_ACTIVATION_MANIFEST environment variable on first activation. The manifest's options are then
+    // read from XLANG_PAL_ACTIVATION_MANIFEST_OPTIONS, a comma-separated list of "preload", "bind_now", and
+    // "exclusive". If that manifest cannot be loaded, the first activation fails and later ones proceed as if
+    // there were no manifest.
+    class activation_manifest
+    {
+    public:
+
+        struct library
+        {
+            std::basic_string<xlang_char8> path;
+            mutable std::once_flag loaded;
+            mutable xlang_pfn_lib_get_activation_factory pfn{};
+        };
+
+        // Relative library paths are resolved against the directory, which is empty or ends with a separator.
+        activation_manifest(
+            std::basic_string_view<xlang_char8> contents,
+            std::basic_string_view<xlang_char8> directory,
+            xlang_activation_manifest_options options);
+
+        activation_manifest(activation_manifest const&) = delete;
+        activation_manifest& operator=(activation_manifest const&) = delete;
+
+        // Returns the manifest in use, or nullptr if there is none.
+        static std::shared_ptr<activation_manifest const> current();
+
+        // Replaces the manifest in use, or removes it if the path is empty. The function is called under the same
+        // lock as the manifest is replaced, so that nothing can observe the new manifest before the function has
+        // run. The previous manifest is released once the lock is.
+        template <typename F>
+        static void load(std::basic_string_view<xlang_char8> path, xlang_activation_manifest_options options, F&& replaced)
+        {
+            auto manifest = open(path, options);
+            std::unique_lock<std::shared_mutex> guard{ get_lock() };
+            swap(manifest);
+            replaced();
+        }
+
+        bool is_exclusive() const noexcept
+        {
+            return (m_options & xlang_activation_manifest_options::exclusive) != xlang_activation_manifest_options::none;
+        }
+
+        // Returns the library that implements the class, or nullptr if the class is not listed.
+        template <typename char_type>
+        library const* find(std::basic_string_view<char_type> class_name) const noexcept
+        {
+            static_assert(sizeof(char_type) == sizeof(xlang_char8) || std::is_same_v<char_type, char16_t>);
+
+            if constexpr (std::is_same_v<char_type, char16_t>)
+            {
+                return find_in(m_utf16_classes, class_name);
+            }
+            else
+            {
+                return find_in(m_utf8_classes, std::basic_string_view<xlang_char8>{
+                    reinterpret_cast<xlang_char8 const*>(class_name.data()), class_name.size() });
+            }
+        }
+
+        // Loads the library on first use, and returns its activation function or nullptr if it has none.
+        xlang_pfn_lib_get_activation_factory get_activation_func(library const& target) const;
+
+    private:
+
+        struct class_entry
+        {
+            std::basic_string<xlang_char8> utf8_name;
+            std::u16string utf16_name;
+            library* target;
+        };
+
+        template <typename map_type, typename key_type>
+        static library const* find_in(map_type const& map, key_type const& class_name) noexcept
+        {
+            auto found = map.find(class_name);
+            return found == map.end() ? nullptr : found->second;
+        }
+
+        static std::shared_ptr<activation_manifest const> open(
+            std::basic_string_view<xlang_char8> path,
+            xlang_activation_manifest_options options);
+
+        static std::shared_mutex& get_lock() noexcept;
+
+        // The caller must hold the lock exclusively.
+        static void swap(std::shared_ptr<activation_manifest const>& manifest) noexcept;
+
+        void parse(std::basic_string_view<xlang_char8> contents, std::basic_string_view<xlang_char8> directory);
+        void index();
+
+        xlang_activation_manifest_options m_options;
+        std::vector<std::unique_ptr<library>> m_libraries;
+        std::vector<class_entry> m_classes;
+
+        // The keys refer to the names held by m_classes, which is not modified once the manifest is indexed.
+        std::unordered_map<std::basic_string_view<xlang_char8>, library const*> m_utf8_classes;
+        std::unordered_map<std::u16string_view, library const*> m_utf16_classes;
+    };
+}
@@ -35,6 +35,15 @@ namespace xlang::impl
             : length_(length)
         {}
 
+        // Strings whose converted form may need no more code units than this are converted on the stack.
+        static constexpr uint32_t stack_conversion_limit = 1024;
+
+        template <typename char_type>
+        static std::unique_ptr<cache_string, xlang_mem_deleter> allocate(uint32_t capacity);
+
+        template <typename char_type>
+        static void initialize(cache_string* value, uint32_t length) noexcept;
+
         cache_string() = delete;
         atomic_ref_count count;
         uint32_t length_{};
@@ -58,9 +67,42 @@ namespace xlang::impl
     {
         static_assert(std::disjunction_v<std::is_same<char_type, xlang_char8>, std::is_same<char_type, char16_t>>, "char_t must be either xlang_char8 or char16_t");
         using alternate_char_type = alternate_string_type_t<char_type>;
-        uint32_t alternate_length = get_converted_length({ source_string, length });
+        std::basic_string_view<char_type> const source{ source_string, length };
+        uint32_t const bound = get_converted_length_bound(source);
+
+        // Converting from UTF-8 never needs more code units than the source, so the string is converted once,
+        // directly into an allocation sized by that bound. Converting from UTF-16 may need three times as many, so
+        // shorter strings are converted once on the stack and copied into an allocation of the right size, and
+        // only longer strings are measured before being converted.
+        if constexpr (std::is_same_v<char_type, xlang_char8>)
+        {
+            auto new_string = allocate<alternate_char_type>(bound);
+            initialize<alternate_char_type>(new_string.get(), convert_string(source, get_packed_buffer_ptr<cache_string, alternate_char_type>(new_string.get()), bound));
+            return new_string;
+        }
+        else if (bound <= stack_conversion_limit)
+        {
+            alternate_char_type buffer[stack_conversion_limit];
+            uint32_t const alternate_length = convert_string(source, buffer, bound);
+            auto new_string = allocate<alternate_char_type>(alternate_length);
+            std::copy_n(buffer, alternate_length, get_packed_buffer_ptr<cache_string, alternate_char_type>(new_string.get()));
+            initialize<alternate_char_type>(new_string.get(), alternate_length);
+            return new_string;
+        }
+        else
+        {
+            uint32_t const alternate_length = get_converted_length(source);
+            auto new_string = allocate<alternate_char_type>(alternate_length);
+            convert_string(source, get_packed_buffer_ptr<cache_string, alternate_char_type>(new_string.get()), alternate_length);
+            initialize<alternate_char_type>(new_string.get(), alternate_length);
+            return new_string;
+        }
+    }
 
-        auto packed_size = packed_buffer_size<cache_string, alternate_char_type>(alternate_length);
+    template <typename char_type>
+    std::unique_ptr<cache_string, xlang_mem_deleter> cache_string::allocate(uint32_t capacity)
+    {
+        auto packed_size = packed_buffer_size<cache_string, char_type>(capacity);
 
         std::unique_ptr<cache_string, xlang_mem_deleter> new_string{ reinterpret_cast<cache_string*>(xlang_mem_alloc(packed_size)) };
         if (!new_string)
@@ -68,14 +110,16 @@ namespace xlang::impl
             throw std::bad_alloc{};
         }
 
-        alternate_char_type* alternate_buffer = get_packed_buffer_ptr<cache_string, alternate_char_type>(new_string.get());
-        convert_string({ source_string, length }, alternate_buffer, alternate_length);
-        alternate_buffer[alternate_length] = 0;
-
-        new (new_string.get()) cache_string(alternate_length);
         return new_string;
     }
 
+    template <typename char_type>
+    void cache_string::initialize(cache_string* value, uint32_t length) noexcept
+    {
+        get_packed_buffer_ptr<cache_string, char_type>(value)[length] = 0;
+        new (value) cache_string(length);
+    }
+
     template <typename char_type>
     inline char_type const* cache_string::get_buffer() const noexcept
     {
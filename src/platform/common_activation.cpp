@@ -4,6 +4,10 @@
 #include "pal_error.h"
 #include <string>
 #include <dlfcn.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
 
 namespace xlang::impl
 {
@@ -13,10 +17,7 @@ namespace xlang::impl
         auto const length = get_converted_length(module_namespace);
         auto converted_name = std::make_unique<xlang_char8[]>(length);
         uint32_t converted_length = convert_string(module_namespace, converted_name.get(), length);
-
-        // Note: common convert_string is incorrectly return zero on success. Using length as a 
-        //       temporary workaround. Tracked by GitHub issue #180
-        return try_get_activation_func({ converted_name.get(), length });
+        return try_get_activation_func({ converted_name.get(), converted_length });
     }
 
     xlang_pfn_lib_get_activation_factory try_get_activation_func(
@@ -39,4 +40,63 @@ namespace xlang::impl
 
         return nullptr;
     }
-}
\ No newline at end of file
+
+    xlang_pfn_lib_get_activation_factory try_load_activation_func(
+        std::basic_string_view<xlang_char8> path,
+        bool bind_now)
+    {
+        std::string module_name{ path };
+        void* module = dlopen(module_name.c_str(), bind_now ? RTLD_NOW : RTLD_LAZY);
+
+        if (module)
+        {
+            return reinterpret_cast<xlang_pfn_lib_get_activation_factory>(dlsym(module, activation_fn_name.data()));
+        }
+
+        return nullptr;
+    }
+
+    mapped_file::mapped_file(std::basic_string_view<xlang_char8> path)
+    {
+        std::string file_name{ path };
+        int file = ::open(file_name.c_str(), O_RDONLY | O_CLOEXEC);
+
+        if (file == -1)
+        {
+            throw_result(xlang_result::invalid_arg, "Unable to open file");
+        }
+
+        struct stat status{};
+
+        if (::fstat(file, &status) == -1)
+        {
+            ::close(file);
+            throw_result(xlang_result::fail, "Unable to read file");
+        }
+
+        // An empty file cannot be mapped, but is simply an empty view.
+        if (status.st_size != 0)
+        {
+            void* data = ::mmap(nullptr, static_cast<size_t>(status.st_size), PROT_READ, MAP_PRIVATE, file, 0);
+
+            if (data == MAP_FAILED)
+            {
+                ::close(file);
+                throw_result(xlang_result::fail, "Unable to map file");
+            }
+
+            m_data = data;
+            m_size = static_cast<size_t>(status.st_size);
+        }
+
+        ::close(file);
+    }
+
+    mapped_file::~mapped_file() noexcept
+    {
+        if (m_data)
+        {
+            ::munmap(m_data, m_size);
+        }
+    }
+}
@@ -1,10 +1,284 @@
 #include <stdlib.h>
-#include "pal.h"
+#include <string.h>
+#include <atomic>
+#include <cstddef>
+#include <iterator>
+#include <limits>
+#include "pal_internal.h"
+#include "memory.h"
+#include "thread_registry.h"
 
 #ifdef _WIN32
 #error "This file is for targeting platforms other than Windows"
 #endif
 
+#if !defined(XLANG_PAL_POOLED_ALLOCATOR)
+#define XLANG_PAL_POOLED_ALLOCATOR 0
+#endif
+
+namespace xlang::impl
+{
+    // The pooled allocator keeps freed blocks of up to 256 bytes in per-thread free lists, one for each size class,
+    // so that the strings and error objects that make up most PAL allocations rarely reach malloc. A block freed on
+    // another thread is pushed onto its owning pool's remote list, which the owner reclaims once its own list for
+    // that size class runs dry. Pools outlive their threads, since their blocks may still be in use, and are adopted
+    // by new threads.
+    //
+    // The allocator is enabled by building with XLANG_PAL_POOLED_ALLOCATOR=1, or by setting the environment variable
+    // XLANG_PAL_ALLOCATOR to "pooled" (or to "system" to override the build). The mode is chosen on first use and
+    // never changes afterwards, since blocks from one mode cannot be freed by the other.
+
+    allocator_mode get_allocator_mode() noexcept
+    {
+        static allocator_mode const mode = []
+        {
+            if (auto value = ::getenv("XLANG_PAL_ALLOCATOR"))
+            {
+                if (::strcmp(value, "pooled") == 0)
+                {
+                    return allocator_mode::pooled;
+                }
+
+                if (::strcmp(value, "system") == 0)
+                {
+                    return allocator_mode::system;
+                }
+            }
+
+            return XLANG_PAL_POOLED_ALLOCATOR ? allocator_mode::pooled : allocator_mode::system;
+        }();
+
+        return mode;
+    }
+
+    namespace pool
+    {
+        constexpr size_t class_sizes[]{ 16, 32, 48, 64, 96, 128, 192, 256 };
+        constexpr uint32_t class_count = static_cast<uint32_t>(std::size(class_sizes));
+        constexpr uint32_t large_class = class_count;
+
+        struct thread_pool;
+
+        // Every block is preceded by a header that records its size class and owning pool. The header's alignment
+        // keeps the block itself aligned for any fundamental type.
+        struct alignas(std::max_align_t) header
+        {
+            thread_pool* owner;
+            uint32_t size_class;
+        };
+
+        struct free_block
+        {
+            free_block* next;
+        };
+
+        // Each pool caches up to 512KB of free blocks in each size class, beyond which freed blocks are returned
+        // to malloc.
+        constexpr uint32_t get_cache_limit(uint32_t size_class) noexcept
+        {
+            return static_cast<uint32_t>((512 * 1024) / (sizeof(header) + class_sizes[size_class]));
+        }
+
+        // Maps each multiple of 16 bytes up to 256 to the smallest size class that can hold it.
+        constexpr uint8_t class_index[]{ 0, 0, 1, 2, 3, 4, 4, 5, 5, 6, 6, 6, 6, 7, 7, 7, 7 };
+
+        inline uint32_t get_size_class(size_t count) noexcept
+        {
+            if (count > class_sizes[class_count - 1])
+            {
+                return large_class;
+            }
+
+            return class_index[(count + 15) / 16];
+        }
+
+        inline header* get_header(void* ptr) noexcept
+        {
+            return static_cast<header*>(ptr) - 1;
+        }
+
+        struct thread_pool
+        {
+            free_block* local[class_count]{};
+            uint32_t cached[class_count]{};
+            std::atomic<free_block*> remote[class_count]{};
+
+            // Only written by the owning thread, but read by get_memory_statistics on any thread.
+            std::atomic<uint64_t> allocations{};
+            std::atomic<uint64_t> frees{};
+            std::atomic<uint64_t> pooled_allocations{};
+            std::atomic<uint64_t> pooled_reuses{};
+            std::atomic<uint64_t> remote_frees{};
+            std::atomic<uint64_t> cached_blocks{};
+
+            void* allocate(size_t count) noexcept
+            {
+                auto const size_class = get_size_class(count);
+                header* block{};
+                bump(allocations);
+
+                if (size_class != large_class)
+                {
+                    bump(pooled_allocations);
+
+                    if (!local[size_class])
+                    {
+                        reclaim(size_class);
+                    }
+
+                    if (auto head = local[size_class])
+                    {
+                        local[size_class] = head->next;
+                        --cached[size_class];
+                        cached_blocks.store(cached_blocks.load(std::memory_order_relaxed) - 1, std::memory_order_relaxed);
+                        bump(pooled_reuses);
+                        block = reinterpret_cast<header*>(head);
+                    }
+                    else
+                    {
+                        block = static_cast<header*>(::malloc(sizeof(header) + class_sizes[size_class]));
+                    }
+                }
+                else
+                {
+                    return allocate_large(this, count);
+                }
+
+                if (!block)
+                {
+                    return nullptr;
+                }
+
+                block->owner = this;
+                block->size_class = size_class;
+                return block + 1;
+            }
+
+            // Blocks of the large class are always returned to malloc, so they need no owner. This allows a thread
+            // that no longer has a pool, because it is exiting, to allocate as well.
+            static void* allocate_large(thread_pool* owner, size_t count) noexcept
+            {
+                if (count > std::numeric_limits<size_t>::max() - sizeof(header))
+                {
+                    return nullptr;
+                }
+
+                auto block = static_cast<header*>(::malloc(sizeof(header) + count));
+
+                if (!block)
+                {
+                    return nullptr;
+                }
+
+                block->owner = owner;
+                block->size_class = large_class;
+                return block + 1;
+            }
+
+            // The current pool may be null if a block is freed while the thread is exiting.
+            static void free(thread_pool* current, header* block) noexcept
+            {
+                auto const size_class = block->size_class;
+
+                if (current)
+                {
+                    bump(current->frees);
+                }
+
+                if (size_class == large_class)
+                {
+                    ::free(block);
+                }
+                else if (block->owner == current)
+                {
+                    current->cache(size_class, reinterpret_cast<free_block*>(block));
+                }
+                else
+                {
+                    if (current)
+                    {
+                        bump(current->remote_frees);
+                    }
+
+                    block->owner->push_remote(size_class, reinterpret_cast<free_block*>(block));
+                }
+            }
+
+        private:
+
+            static void bump(std::atomic<uint64_t>& counter) noexcept
+            {
+                counter.store(counter.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+            }
+
+            void cache(uint32_t size_class, free_block* block) noexcept
+            {
+                if (cached[size_class] == get_cache_limit(size_class))
+                {
+                    ::free(block);
+                    return;
+                }
+
+                block->next = local[size_class];
+                local[size_class] = block;
+                ++cached[size_class];
+                bump(cached_blocks);
+            }
+
+            void push_remote(uint32_t size_class, free_block* block) noexcept
+            {
+                auto& head = remote[size_class];
+                block->next = head.load(std::memory_order_relaxed);
+
+                while (!head.compare_exchange_weak(block->next, block, std::memory_order_release, std::memory_order_relaxed))
+                {
+                }
+            }
+
+            // Taking the whole remote list at once means that blocks are only ever pushed concurrently, which
+            // avoids the ABA problem of popping them one at a time.
+            void reclaim(uint32_t size_class) noexcept
+            {
+                auto block = remote[size_class].exchange(nullptr, std::memory_order_acquire);
+
+                while (block)
+                {
+                    auto next = block->next;
+                    cache(size_class, block);
+                    block = next;
+                }
+            }
+        };
+
+        inline thread_pool* current() noexcept
+        {
+            return thread_registry<thread_pool>::current();
+        }
+    }
+
+    memory_statistics get_memory_statistics() noexcept
+    {
+        memory_statistics result{ get_allocator_mode() };
+
+        if (result.mode != allocator_mode::pooled)
+        {
+            return result;
+        }
+
+        thread_registry<pool::thread_pool>::for_each([&](pool::thread_pool const& pool)
+        {
+            result.allocations += pool.allocations.load(std::memory_order_relaxed);
+            result.frees += pool.frees.load(std::memory_order_relaxed);
+            result.pooled_allocations += pool.pooled_allocations.load(std::memory_order_relaxed);
+            result.pooled_reuses += pool.pooled_reuses.load(std::memory_order_relaxed);
+            result.remote_frees += pool.remote_frees.load(std::memory_order_relaxed);
+            result.cached_blocks += pool.cached_blocks.load(std::memory_order_relaxed);
+        });
+
+        return result;
+    }
+}
+
 extern "C"
 {
     void* XLANG_CALL xlang_mem_alloc(size_t count) noexcept
@@ -13,11 +287,28 @@ extern "C"
         {
             count = 1;
         }
+
+        if (xlang::impl::get_allocator_mode() == xlang::impl::allocator_mode::pooled)
+        {
+            if (auto pool = xlang::impl::pool::current())
+            {
+                return pool->allocate(count);
+            }
+
+            return xlang::impl::pool::thread_pool::allocate_large(nullptr, count);
+        }
+
         return ::malloc(count);
     }
 
     void XLANG_CALL xlang_mem_free(void* ptr) noexcept
     {
+        if (ptr && xlang::impl::get_allocator_mode() == xlang::impl::allocator_mode::pooled)
+        {
+            xlang::impl::pool::thread_pool::free(xlang::impl::pool::current(), xlang::impl::pool::get_header(ptr));
+            return;
+        }
+
         ::free(ptr);
     }
 }
@@ -3,6 +3,10 @@
 #include "pal_error.h"
 #include "string_traits.h"
 
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
 namespace xlang::impl::convert
 {
     using utf8_worker_t = std::conditional_t<std::is_signed_v<xlang_char8>, uint8_t, xlang_char8>;
@@ -227,6 +231,125 @@ namespace xlang::impl::convert
         }
     }
 
+    // Identifiers, file names and most other strings that cross the ABI are entirely or largely ASCII, which has
+    // the same code units in both encodings. Runs of ASCII are therefore measured and copied a block at a time,
+    // leaving only the remaining code points to the scalar converters above.
+
+    template <typename T>
+    inline bool is_ascii(T value) noexcept
+    {
+        return value <= 0x7f;
+    }
+
+#if defined(__SSE2__)
+    inline bool is_ascii_block(__m128i block) noexcept
+    {
+        return _mm_movemask_epi8(block) == 0;
+    }
+
+    inline bool is_ascii_block(__m128i low, __m128i high) noexcept
+    {
+        auto const mask = _mm_set1_epi16(static_cast<short>(0xff80));
+        auto const combined = _mm_and_si128(_mm_or_si128(low, high), mask);
+        return _mm_movemask_epi8(_mm_cmpeq_epi16(combined, _mm_setzero_si128())) == 0xffff;
+    }
+#endif
+
+    void skip_ascii(utf8_worker_t const*& begin, utf8_worker_t const* end) noexcept
+    {
+#if defined(__SSE2__)
+        while (end - begin >= 16)
+        {
+            auto const block = _mm_loadu_si128(reinterpret_cast<__m128i const*>(begin));
+            auto const mask = _mm_movemask_epi8(block);
+
+            if (mask != 0)
+            {
+                begin += __builtin_ctz(static_cast<unsigned>(mask));
+                return;
+            }
+
+            begin += 16;
+        }
+#endif
+        while (begin != end && is_ascii(*begin))
+        {
+            ++begin;
+        }
+    }
+
+    void skip_ascii(char16_t const*& begin, char16_t const* end) noexcept
+    {
+#if defined(__SSE2__)
+        while (end - begin >= 16)
+        {
+            auto const low = _mm_loadu_si128(reinterpret_cast<__m128i const*>(begin));
+            auto const high = _mm_loadu_si128(reinterpret_cast<__m128i const*>(begin + 8));
+
+            if (!is_ascii_block(low, high))
+            {
+                break;
+            }
+
+            begin += 16;
+        }
+#endif
+        while (begin != end && is_ascii(*begin))
+        {
+            ++begin;
+        }
+    }
+
+    void copy_ascii(utf8_worker_t const*& begin, utf8_worker_t const* end, char16_t*& output) noexcept
+    {
+#if defined(__SSE2__)
+        auto const zero = _mm_setzero_si128();
+
+        while (end - begin >= 16)
+        {
+            auto const block = _mm_loadu_si128(reinterpret_cast<__m128i const*>(begin));
+
+            if (!is_ascii_block(block))
+            {
+                break;
+            }
+
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(output), _mm_unpacklo_epi8(block, zero));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(output + 8), _mm_unpackhi_epi8(block, zero));
+            begin += 16;
+            output += 16;
+        }
+#endif
+        while (begin != end && is_ascii(*begin))
+        {
+            *output++ = *begin++;
+        }
+    }
+
+    void copy_ascii(char16_t const*& begin, char16_t const* end, utf8_worker_t*& output) noexcept
+    {
+#if defined(__SSE2__)
+        while (end - begin >= 16)
+        {
+            auto const low = _mm_loadu_si128(reinterpret_cast<__m128i const*>(begin));
+            auto const high = _mm_loadu_si128(reinterpret_cast<__m128i const*>(begin + 8));
+
+            if (!is_ascii_block(low, high))
+            {
+                break;
+            }
+
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(output), _mm_packus_epi16(low, high));
+            begin += 16;
+            output += 16;
+        }
+#endif
+        while (begin != end && is_ascii(*begin))
+        {
+            *output++ = static_cast<utf8_worker_t>(*begin++);
+        }
+    }
+
     template <typename T>
     uint32_t get_converted_length(std::basic_string_view<T> input_str)
     {
@@ -237,6 +360,14 @@ namespace xlang::impl::convert
         uint32_t length = 0;
         while (input_cursor != input_end)
         {
+            if (is_ascii(*input_cursor))
+            {
+                auto const run = input_cursor;
+                skip_ascii(input_cursor, input_end);
+                length += static_cast<uint32_t>(input_cursor - run);
+                continue;
+            }
+
             auto code_point = converter<T>::decode(input_cursor, input_end);
             length += converter<output_type>::encoded_length(code_point);
         }
@@ -255,11 +386,17 @@ namespace xlang::impl::convert
         const auto output_end = output_cursor + buffer_size;
         while (input_cursor != input_end)
         {
+            if (is_ascii(*input_cursor))
+            {
+                copy_ascii(input_cursor, input_end, output_cursor);
+                continue;
+            }
+
             auto code_point = converter<T>::decode(input_cursor, input_end);
             converter<output_type>::encode(code_point, output_cursor, output_end);
         }
-        XLANG_ASSERT(output_cursor == output_end);
-        return static_cast<uint32_t>(output_cursor - output_end);
+        XLANG_ASSERT(output_cursor <= output_end);
+        return static_cast<uint32_t>(output_cursor - to_worker(output_buffer));
     }
 }
 
@@ -1,13 +1,16 @@
 #include "pal_internal.h"
 #include "pal_error.h"
 #include "atomic_ref_count.h"
+#include "pal_statistics.h"
 #include <xlang/base.h>
+#include <iterator>
 
 namespace xlang::impl
 {
     struct error_info : xlang_error_info
     {
-        // Used to construct constant errors used in out of memory scenarios.
+        // Used to construct the constant errors shared by errors that carry nothing but their result, and used
+        // when an error info cannot be allocated.
         explicit error_info(xlang_result result) noexcept :
             m_result{ result },
             m_modifiable{ false }
@@ -24,6 +27,7 @@ namespace xlang::impl
         ) noexcept :
             m_result{ result }
         {   
+            count(&pal_counters::live_error_infos);
             m_execution_trace.copy_from(execution_trace);
             m_language_information.copy_from(language_information);
 
@@ -69,6 +73,7 @@ namespace xlang::impl
             auto result = --m_count;
             if (result == 0)
             {
+                count(&pal_counters::live_error_infos, -1);
                 delete this;
             }
             return result;
@@ -156,6 +161,7 @@ namespace xlang::impl
         atomic_ref_count m_count;
     };
 
+    // Indexed by xlang_result, less one since success has no error.
     error_info error_code_errors [] = {
         error_info {xlang_result::access_denied},
         error_info {xlang_result::bounds},
@@ -169,6 +175,12 @@ namespace xlang::impl
         error_info {xlang_result::pointer},
         error_info {xlang_result::type_load}
     };
+
+    error_info* get_constant_error(xlang_result result) noexcept
+    {
+        auto const index = static_cast<uint32_t>(result) - 1;
+        return index < std::size(error_code_errors) ? &error_code_errors[index] : nullptr;
+    }
 }
 
 [[nodiscard]] XLANG_PAL_EXPORT xlang_error_info* XLANG_CALL xlang_originate_error(
@@ -180,6 +192,21 @@ namespace xlang::impl
     xlang_unknown* language_information
 ) XLANG_NOEXCEPT
 {
+    using namespace xlang::impl;
+    count(&pal_counters::total_error_infos);
+
+    // Projections use errors for control flow, such as a failed lookup, so errors that carry nothing but their
+    // result share a constant error info rather than allocating one. Like those used when allocation fails, these
+    // cannot be modified, so propagating them records nothing.
+    if (!message && !projection_identifier && !language_error && !execution_trace && !language_information)
+    {
+        if (xlang_error_info* shared = get_constant_error(error))
+        {
+            shared->AddRef();
+            return shared;
+        }
+    }
+
     xlang_error_info* error_info =
         new (std::nothrow) xlang::impl::error_info
     {
@@ -194,7 +221,13 @@ namespace xlang::impl
     // If failed to construct, use the statically allocated ones.
     if (error_info == nullptr)
     {
-        error_info = &xlang::impl::error_code_errors[static_cast<int>(error)];
+        error_info = get_constant_error(error);
+
+        if (!error_info)
+        {
+            error_info = get_constant_error(xlang_result::out_of_memory);
+        }
+
         error_info->AddRef();
     }
 
@@ -4,6 +4,9 @@
 #include "atomic_ref_count.h"
 #include "heap_string.h"
 #include "cache_string.h"
+#include "string_buffer_pool.h"
+#include "small_string.h"
+#include "pal_statistics.h"
 
 namespace xlang::impl
 {
@@ -28,6 +31,12 @@ namespace xlang::impl
         template <typename char_type>
         static heap_string* create_preallocated(uint32_t length);
 
+        // Creates a string for the interned or small string tables, which own it for the life of the process.
+        template <typename char_type>
+        static heap_string* create_interned(
+            char_type const* source_string,
+            uint32_t length);
+
         heap_string* promote_preallocated(uint32_t length);
         void free_preallocated();
 
@@ -40,7 +49,6 @@ namespace xlang::impl
 
         // Diagnostics
         int32_t get_ref_count() const noexcept;
-        uint32_t get_total_string_count() const noexcept;
 
     private:
         template <typename char_type>
@@ -62,8 +70,11 @@ namespace xlang::impl
             uint32_t length,
             cache_string* alternate);
 
+        // Adds to or removes from the statistics for heap strings of the given length.
+        template <typename char_type>
+        static void count_heap_string(uint32_t length, int64_t delta) noexcept;
+
         atomic_ref_count count;
-        inline static std::atomic<uint32_t> total_string_count{ 0 };
     };
 
     template <typename char_type>
@@ -75,7 +86,13 @@ namespace xlang::impl
         {
             return nullptr;
         }
-        return create_impl(source_string, length, nullptr);
+        if (auto small = find_small_string(source_string, length))
+        {
+            return small;
+        }
+        heap_string* result = create_impl(source_string, length, nullptr);
+        count_heap_string<char_type>(length, 1);
+        return result;
     }
 
     template <typename char_type>
@@ -88,14 +105,41 @@ namespace xlang::impl
         {
             return nullptr;
         }
-        return create_impl(source_string, length, alternate);
+        // A duplicated reference keeps sharing its converted form, which a small string cannot.
+        if (!alternate)
+        {
+            if (auto small = find_small_string(source_string, length))
+            {
+                return small;
+            }
+        }
+        heap_string* result = create_impl(source_string, length, alternate);
+        count_heap_string<char_type>(length, 1);
+        return result;
     }
 
     template <typename char_type>
     heap_string* heap_string::create_preallocated(uint32_t length)
     {
-        heap_string* result = heap_string::create_impl<char_type>(nullptr, length, nullptr);
-        result->mutable_buffer<char_type>()[length] = 0;
+        uint32_t size_class{};
+        heap_string* result = reinterpret_cast<heap_string*>(
+            allocate_string_buffer(packed_buffer_size<heap_string, char_type>(length), size_class));
+
+        new (result) heap_string(static_cast<char_type const*>(nullptr), length, get_packed_buffer_ptr<heap_string, char_type>(result));
+        result->set_buffer_pool_class(size_class);
+        count_heap_string<char_type>(length, 1);
+        return result;
+    }
+
+    template <typename char_type>
+    heap_string* heap_string::create_interned(
+        char_type const* source_string,
+        uint32_t length)
+    {
+        XLANG_ASSERT(length != 0);
+        heap_string* result = create_impl(source_string, length, nullptr);
+        result->mark_interned();
+        count_string<char_type>(&pal_counters::string_counters::interned_strings);
         return result;
     }
 
@@ -121,9 +165,26 @@ namespace xlang::impl
         return count.get_count();
     }
 
-    inline uint32_t heap_string::get_total_string_count() const noexcept
+    template <typename char_type>
+    inline void heap_string::count_heap_string(uint32_t length, int64_t delta) noexcept
     {
-        return total_string_count.load(std::memory_order_acquire);
+        auto counters = thread_registry<pal_counters>::current();
+
+        if (!counters)
+        {
+            return;
+        }
+
+        auto& strings = get_string_counters<char_type>(*counters);
+        auto const size = static_cast<int64_t>(sizeof(heap_string) + (static_cast<uint64_t>(length) + 1) * sizeof(char_type));
+        add_to(strings.live_heap_strings, delta);
+        add_to(strings.heap_string_bytes, delta * size);
+
+        if (delta > 0)
+        {
+            add_to(strings.total_heap_strings, delta);
+            add_to(strings.total_heap_string_bytes, delta * size);
+        }
     }
 
     template <typename char_type>
@@ -147,17 +208,10 @@ namespace xlang::impl
         }
 
         char_storage[length] = 0;
-
-#ifdef _DEBUG
-        ++total_string_count;
-#endif
     }
 
     inline heap_string::~heap_string() noexcept
     {
-#ifdef _DEBUG
-        --total_string_count;
-#endif
     }
 
     inline heap_string* heap_string::promote_preallocated(uint32_t length)
@@ -172,16 +226,31 @@ namespace xlang::impl
         {
             throw_result(xlang_result::invalid_arg);
         }
+        if (length == 1)
+        {
+            heap_string* small = is_utf8() ?
+                find_small_string(mutable_buffer<xlang_char8>(), length) :
+                find_small_string(mutable_buffer<char16_t>(), length);
+
+            if (small)
+            {
+                release();
+                return small;
+            }
+        }
         if (length > 0)
         {
             bool const utf8 = is_utf8();
+            auto const unused = static_cast<int64_t>(get_length() - length);
             if (is_utf8())
             {
                 mutable_buffer<xlang_char8>()[length] = 0;
+                count_string<xlang_char8>(&pal_counters::string_counters::heap_string_bytes, -unused * static_cast<int64_t>(sizeof(xlang_char8)));
             }
             else
             {
                 mutable_buffer<char16_t>()[length] = 0;
+                count_string<char16_t>(&pal_counters::string_counters::heap_string_bytes, -unused * static_cast<int64_t>(sizeof(char16_t)));
             }
             update_preallocated_length(length);
             promote_string_buffer_flags();
@@ -222,7 +291,28 @@ namespace xlang::impl
                 alternate->release();
             }
 
-            xlang_mem_free(this);
+            // Only strings that lost a race to be added to a table of immortal strings are freed while interned.
+            if (is_interned())
+            {
+                is_utf8() ?
+                    count_string<xlang_char8>(&pal_counters::string_counters::interned_strings, -1) :
+                    count_string<char16_t>(&pal_counters::string_counters::interned_strings, -1);
+            }
+            else
+            {
+                is_utf8() ?
+                    count_heap_string<xlang_char8>(get_length(), -1) :
+                    count_heap_string<char16_t>(get_length(), -1);
+            }
+
+            if (auto const size_class = get_buffer_pool_class())
+            {
+                free_string_buffer(this, size_class);
+            }
+            else
+            {
+                xlang_mem_free(this);
+            }
         }
         return result;
     }
@@ -0,0 +1,93 @@
+#include "interned_string.h"
+#include <limits>
+#include <mutex>
+#include <shared_mutex>
+#include <unordered_map>
+
+namespace xlang::impl
+{
+    // The table is sharded by hash so that threads interning different strings rarely contend, and each shard is
+    // guarded by a reader-writer lock since lookups of strings that are already interned far outnumber insertions.
+    // The keys refer to the interned strings' own buffers, which live as long as the table.
+    template <typename char_type>
+    struct intern_table
+    {
+        using key_type = std::basic_string_view<char_type>;
+
+        static intern_table& get()
+        {
+            // Deliberately leaked so that interned strings remain valid while static objects are destroyed.
+            static intern_table* value = new intern_table;
+            return *value;
+        }
+
+        heap_string* intern(key_type const& value)
+        {
+            if (auto small = find_small_string(value.data(), static_cast<uint32_t>(value.size())))
+            {
+                return small;
+            }
+
+            auto const hash = std::hash<key_type>{}(value);
+
+            // The high bits choose the shard so that the low bits, which the shard's own buckets use, stay evenly
+            // distributed within each shard.
+            auto& target = shards[hash >> (std::numeric_limits<size_t>::digits - shard_bits)];
+
+            {
+                std::shared_lock<std::shared_mutex> guard{ target.lock };
+                auto found = target.strings.find(value);
+
+                if (found != target.strings.end())
+                {
+                    return found->second;
+                }
+            }
+
+            std::unique_lock<std::shared_mutex> guard{ target.lock };
+            auto found = target.strings.find(value);
+
+            if (found != target.strings.end())
+            {
+                return found->second;
+            }
+
+            auto const length = static_cast<uint32_t>(value.size());
+            heap_string* result = heap_string::create_interned(value.data(), length);
+
+            try
+            {
+                target.strings.emplace(key_type{ result->get_buffer<char_type>(), length }, result);
+            }
+            catch (...)
+            {
+                result->release();
+                throw;
+            }
+
+            return result;
+        }
+
+    private:
+
+        static constexpr size_t shard_bits = 4;
+
+        struct shard
+        {
+            std::shared_mutex lock;
+            std::unordered_map<key_type, heap_string*> strings;
+        };
+
+        shard shards[size_t{ 1 } << shard_bits];
+    };
+
+    heap_string* intern_string(std::basic_string_view<xlang_char8> value)
+    {
+        return intern_table<xlang_char8>::get().intern(value);
+    }
+
+    heap_string* intern_string(std::basic_string_view<char16_t> value)
+    {
+        return intern_table<char16_t>::get().intern(value);
+    }
+}
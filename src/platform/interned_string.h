@@ -0,0 +1,12 @@
+#pragma once
+
+#include <string_view>
+#include "heap_string.h"
+
+namespace xlang::impl
+{
+    // Returns the process-wide interned string with the given value, creating it on first use. UTF-8 and UTF-16
+    // strings are interned separately, so the same text interned in each encoding yields two strings.
+    heap_string* intern_string(std::basic_string_view<xlang_char8> value);
+    heap_string* intern_string(std::basic_string_view<char16_t> value);
+}
@@ -0,0 +1,27 @@
+#pragma once
+
+#include <stdint.h>
+
+namespace xlang::impl
+{
+    enum class allocator_mode : uint32_t
+    {
+        system,
+        pooled,
+    };
+
+    // Counters for the blocks handed out by xlang_mem_alloc. Only the pooled allocator keeps them, so they are
+    // all zero in system mode.
+    struct memory_statistics
+    {
+        allocator_mode mode;
+        uint64_t allocations;
+        uint64_t frees;
+        uint64_t pooled_allocations;
+        uint64_t pooled_reuses;
+        uint64_t remote_frees;
+        uint64_t cached_blocks;
+    };
+
+    memory_statistics get_memory_statistics() noexcept;
+}
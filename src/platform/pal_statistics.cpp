@@ -0,0 +1,101 @@
+#include "pal_internal.h"
+#include "pal_statistics.h"
+#include "string_buffer_pool.h"
+#include "memory.h"
+
+namespace xlang::impl
+{
+    namespace
+    {
+        // The live counts are summed from counters that may individually be negative, and a snapshot taken while
+        // strings are moving between threads could briefly be too, so the totals are clamped at zero.
+        uint64_t to_statistic(int64_t value) noexcept
+        {
+            return value < 0 ? 0 : static_cast<uint64_t>(value);
+        }
+
+        struct string_totals
+        {
+            int64_t live_heap_strings;
+            int64_t total_heap_strings;
+            int64_t heap_string_bytes;
+            int64_t total_heap_string_bytes;
+            int64_t string_references;
+            int64_t interned_strings;
+            int64_t conversions;
+
+            void add(pal_counters::string_counters const& counters) noexcept
+            {
+                live_heap_strings += counters.live_heap_strings.load(std::memory_order_relaxed);
+                total_heap_strings += counters.total_heap_strings.load(std::memory_order_relaxed);
+                heap_string_bytes += counters.heap_string_bytes.load(std::memory_order_relaxed);
+                total_heap_string_bytes += counters.total_heap_string_bytes.load(std::memory_order_relaxed);
+                string_references += counters.string_references.load(std::memory_order_relaxed);
+                interned_strings += counters.interned_strings.load(std::memory_order_relaxed);
+                conversions += counters.conversions.load(std::memory_order_relaxed);
+            }
+
+            xlang_string_statistics get() const noexcept
+            {
+                return
+                {
+                    to_statistic(live_heap_strings),
+                    to_statistic(total_heap_strings),
+                    to_statistic(heap_string_bytes),
+                    to_statistic(total_heap_string_bytes),
+                    to_statistic(string_references),
+                    to_statistic(interned_strings),
+                    to_statistic(conversions),
+                };
+            }
+        };
+    }
+}
+
+XLANG_PAL_EXPORT void XLANG_CALL xlang_get_pal_statistics(
+    xlang_pal_statistics* statistics
+) XLANG_NOEXCEPT
+{
+    using namespace xlang::impl;
+
+    string_totals utf8_strings{};
+    string_totals utf16_strings{};
+    int64_t live_error_infos{};
+    int64_t total_error_infos{};
+    int64_t activation_cache_hits{};
+    int64_t activation_cache_misses{};
+    int64_t activation_module_probes{};
+
+    thread_registry<pal_counters>::for_each([&](pal_counters const& counters)
+    {
+        utf8_strings.add(counters.utf8_strings);
+        utf16_strings.add(counters.utf16_strings);
+        live_error_infos += counters.live_error_infos.load(std::memory_order_relaxed);
+        total_error_infos += counters.total_error_infos.load(std::memory_order_relaxed);
+        activation_cache_hits += counters.activation_cache_hits.load(std::memory_order_relaxed);
+        activation_cache_misses += counters.activation_cache_misses.load(std::memory_order_relaxed);
+        activation_module_probes += counters.activation_module_probes.load(std::memory_order_relaxed);
+    });
+
+    auto const memory = get_memory_statistics();
+
+    *statistics = {};
+    statistics->utf8_strings = utf8_strings.get();
+    statistics->utf16_strings = utf16_strings.get();
+    statistics->string_buffer_pool = get_string_buffer_pool_statistics();
+    statistics->allocator =
+    {
+        memory.mode == allocator_mode::pooled,
+        memory.allocations,
+        memory.frees,
+        memory.pooled_allocations,
+        memory.pooled_reuses,
+        memory.remote_frees,
+        memory.cached_blocks,
+    };
+    statistics->live_error_infos = to_statistic(live_error_infos);
+    statistics->total_error_infos = to_statistic(total_error_infos);
+    statistics->activation_cache_hits = to_statistic(activation_cache_hits);
+    statistics->activation_cache_misses = to_statistic(activation_cache_misses);
+    statistics->activation_module_probes = to_statistic(activation_module_probes);
+}
@@ -0,0 +1,67 @@
+#pragma once
+
+#include "pal.h"
+#include <atomic>
+#include <type_traits>
+#include "thread_registry.h"
+
+namespace xlang::impl
+{
+    // Counters behind xlang_get_pal_statistics. Each thread has its own counters, which only it writes, so that
+    // counting costs a plain load and store rather than an atomic read-modify-write; xlang_get_pal_statistics
+    // sums them. A string created on one thread and freed on another leaves one thread's live count high and the
+    // other's low, which cancel out in the sum. Events on threads that are exiting are not counted.
+    struct pal_counters
+    {
+        struct string_counters
+        {
+            std::atomic<int64_t> live_heap_strings{};
+            std::atomic<int64_t> total_heap_strings{};
+            std::atomic<int64_t> heap_string_bytes{};
+            std::atomic<int64_t> total_heap_string_bytes{};
+            std::atomic<int64_t> string_references{};
+            std::atomic<int64_t> interned_strings{};
+            std::atomic<int64_t> conversions{};
+        };
+
+        string_counters utf8_strings{};
+        string_counters utf16_strings{};
+        std::atomic<int64_t> live_error_infos{};
+        std::atomic<int64_t> total_error_infos{};
+        std::atomic<int64_t> activation_cache_hits{};
+        std::atomic<int64_t> activation_cache_misses{};
+        std::atomic<int64_t> activation_module_probes{};
+    };
+
+    // Counters are only written by their own thread, so a plain load and store suffices.
+    inline void add_to(std::atomic<int64_t>& counter, int64_t delta) noexcept
+    {
+        counter.store(counter.load(std::memory_order_relaxed) + delta, std::memory_order_relaxed);
+    }
+
+    template <typename char_type>
+    inline pal_counters::string_counters& get_string_counters(pal_counters& counters) noexcept
+    {
+        static_assert(std::disjunction_v<std::is_same<char_type, xlang_char8>, std::is_same<char_type, char16_t>>);
+        return std::is_same_v<char_type, xlang_char8> ? counters.utf8_strings : counters.utf16_strings;
+    }
+
+    // Adds to a counter of the current thread, chosen by a pointer to member such as &pal_counters::total_error_infos.
+    inline void count(std::atomic<int64_t> pal_counters::* member, int64_t delta = 1) noexcept
+    {
+        if (auto counters = thread_registry<pal_counters>::current())
+        {
+            add_to(counters->*member, delta);
+        }
+    }
+
+    // Adds to a string counter of the current thread for the given encoding.
+    template <typename char_type>
+    inline void count_string(std::atomic<int64_t> pal_counters::string_counters::* member, int64_t delta = 1) noexcept
+    {
+        if (auto counters = thread_registry<pal_counters>::current())
+        {
+            add_to(get_string_counters<char_type>(*counters).*member, delta);
+        }
+    }
+}
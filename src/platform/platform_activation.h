@@ -19,6 +19,34 @@ namespace xlang::impl
     xlang_pfn_lib_get_activation_factory try_get_activation_func(
         std::basic_string_view<char16_t> module_namespace);
 
+    // Loads the library at a path listed in an activation manifest, resolving all of its symbols immediately if
+    // bind_now is set and the platform supports deferring them, and returns its activation function.
+    xlang_pfn_lib_get_activation_factory try_load_activation_func(
+        std::basic_string_view<xlang_char8> path,
+        bool bind_now);
+
+    // A read-only mapping of an entire file.
+    class mapped_file
+    {
+    public:
+
+        explicit mapped_file(std::basic_string_view<xlang_char8> path);
+        ~mapped_file() noexcept;
+
+        mapped_file(mapped_file const&) = delete;
+        mapped_file& operator=(mapped_file const&) = delete;
+
+        std::basic_string_view<xlang_char8> data() const noexcept
+        {
+            return { static_cast<xlang_char8 const*>(m_data), m_size };
+        }
+
+    private:
+
+        void* m_data{};
+        size_t m_size{};
+    };
+
     template <typename char_type>
     inline constexpr std::basic_string_view<char_type> enclosing_namespace(std::basic_string_view<char_type> str) noexcept
     {
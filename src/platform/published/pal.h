@@ -215,6 +215,25 @@ extern "C"
     };
 #endif
 
+#ifdef __cplusplus
+    enum class xlang_activation_manifest_options : uint32_t
+    {
+        none = 0x0,
+        preload = 0x1,
+        bind_now = 0x2,
+        exclusive = 0x4
+    };
+
+#else
+    enum xlang_activation_manifest_options
+    {
+        XlangActivationManifestOptionsNone = 0x0,
+        XlangActivationManifestOptionsPreload = 0x1,
+        XlangActivationManifestOptionsBindNow = 0x2,
+        XlangActivationManifestOptionsExclusive = 0x4
+    };
+#endif
+
 #ifdef __cplusplus
     enum class xlang_result : uint32_t
     {
@@ -283,6 +302,19 @@ extern "C"
         xlang_string* string
     ) XLANG_NOEXCEPT;
 
+    // Interned strings are shared by the whole process and never freed. Creating an interned string with the same
+    // value and encoding always returns the same handle, and duplicating or deleting it does nothing.
+    XLANG_PAL_EXPORT xlang_error_info* XLANG_CALL xlang_create_interned_string_utf8(
+        xlang_char8 const* source_string,
+        uint32_t length,
+        xlang_string* string
+    ) XLANG_NOEXCEPT;
+    XLANG_PAL_EXPORT xlang_error_info* XLANG_CALL xlang_create_interned_string_utf16(
+        char16_t const* source_string,
+        uint32_t length,
+        xlang_string* string
+    ) XLANG_NOEXCEPT;
+
     XLANG_PAL_EXPORT xlang_error_info* XLANG_CALL xlang_create_string_reference_utf8(
         xlang_char8 const* source_string,
         uint32_t length,
@@ -337,12 +369,81 @@ extern "C"
         uint32_t length
     ) XLANG_NOEXCEPT;
 
+    // Counters for the pool that recycles preallocated string buffers, summed over all threads.
+    struct xlang_string_buffer_pool_statistics
+    {
+        uint64_t allocations;   // Buffers preallocated
+        uint64_t reuses;        // Buffers preallocated from a recycled block
+        uint64_t recycles;      // Blocks returned to the pool when their strings were freed
+        uint64_t discards;      // Blocks freed because the pool was full
+        uint64_t cached_blocks; // Blocks currently held by the pool
+    };
+
+    // Counters for the strings of one encoding. Heap strings include promoted string buffers, but not interned
+    // strings or shared single-character strings, which are counted as interned strings and never freed.
+    struct xlang_string_statistics
+    {
+        uint64_t live_heap_strings;       // Heap strings and string buffers not yet freed
+        uint64_t total_heap_strings;      // Heap strings and string buffers ever created
+        uint64_t heap_string_bytes;       // Bytes held by live heap strings, including their headers
+        uint64_t total_heap_string_bytes; // Bytes ever held by heap strings
+        uint64_t string_references;       // String references ever created
+        uint64_t interned_strings;        // Interned and shared strings
+        uint64_t conversions;             // Strings of this encoding converted to the other encoding
+    };
+
+    // Counters kept by the pooled allocator behind xlang_mem_alloc, which are all zero unless it is in use.
+    struct xlang_allocator_statistics
+    {
+        uint32_t pooled;                  // Nonzero if xlang_mem_alloc uses the pooled allocator
+        uint64_t allocations;
+        uint64_t frees;
+        uint64_t pooled_allocations;      // Allocations small enough to be pooled
+        uint64_t pooled_reuses;           // Pooled allocations that reused a freed block
+        uint64_t remote_frees;            // Blocks freed by a thread other than the one that allocated them
+        uint64_t cached_blocks;           // Freed blocks held for reuse
+    };
+
+    // A snapshot of the PAL's counters, summed over all threads. The counters are updated without
+    // synchronization between threads, so a snapshot taken while other threads are busy may be slightly stale.
+    struct xlang_pal_statistics
+    {
+        xlang_string_statistics utf8_strings;
+        xlang_string_statistics utf16_strings;
+        xlang_string_buffer_pool_statistics string_buffer_pool;
+        xlang_allocator_statistics allocator;
+        uint64_t live_error_infos;        // Error infos originated and not yet released
+        uint64_t total_error_infos;       // Error infos ever originated
+        uint64_t activation_cache_hits;   // Activations served by a cached factory
+        uint64_t activation_cache_misses; // Activations that called a library's activation function
+        uint64_t activation_module_probes; // Libraries looked up for activation
+    };
+
+    XLANG_PAL_EXPORT void XLANG_CALL xlang_get_pal_statistics(
+        xlang_pal_statistics* statistics
+    ) XLANG_NOEXCEPT;
+
     XLANG_PAL_EXPORT xlang_error_info* XLANG_CALL xlang_get_activation_factory(
         xlang_string class_name,
         xlang_guid const& iid,
         void** factory
     ) XLANG_NOEXCEPT;
 
+    // Activation caches the modules, activation functions, and factories it resolves, including failures to
+    // resolve a class. Clearing the cache releases the cached factories, so that modules installed or replaced
+    // since are picked up.
+    XLANG_PAL_EXPORT void XLANG_CALL xlang_clear_activation_factory_cache() XLANG_NOEXCEPT;
+
+    // Loads a manifest mapping runtime class names to the libraries that implement them, replacing any manifest
+    // already loaded, or removes the current manifest if path is null. Activating a listed class then loads its
+    // library directly; other classes are still found by namespace unless the manifest is exclusive. A relative
+    // library path that names a directory is relative to the manifest's directory. With preload, every listed
+    // library is loaded immediately, and bind_now resolves each library's symbols as it is loaded.
+    XLANG_PAL_EXPORT xlang_error_info* XLANG_CALL xlang_load_activation_manifest(
+        xlang_string path,
+        xlang_activation_manifest_options options
+    ) XLANG_NOEXCEPT;
+
     typedef xlang_result(XLANG_CALL * xlang_pfn_lib_get_activation_factory)(xlang_string, xlang_guid const&, void **);
 
 #ifdef __cplusplus
@@ -392,6 +493,18 @@ constexpr xlang_string_encoding& operator&=(xlang_string_encoding& lhs, xlang_st
     lhs = lhs & rhs;
     return lhs;
 }
+
+constexpr xlang_activation_manifest_options operator|(xlang_activation_manifest_options lhs, xlang_activation_manifest_options rhs) noexcept
+{
+    using int_t = std::underlying_type_t<xlang_activation_manifest_options>;
+    return static_cast<xlang_activation_manifest_options>(static_cast<int_t>(lhs) | static_cast<int_t>(rhs));
+}
+
+constexpr xlang_activation_manifest_options operator&(xlang_activation_manifest_options lhs, xlang_activation_manifest_options rhs) noexcept
+{
+    using int_t = std::underlying_type_t<xlang_activation_manifest_options>;
+    return static_cast<xlang_activation_manifest_options>(static_cast<int_t>(lhs) & static_cast<int_t>(rhs));
+}
 #endif
 
 #endif
\ No newline at end of file
@@ -0,0 +1,59 @@
+#include "small_string.h"
+#include "heap_string.h"
+
+namespace xlang::impl
+{
+    namespace
+    {
+        // The table is filled in lazily, so a string that is never used is never allocated. Its entries are never
+        // freed, and have no destructor, so they remain usable while static objects are destroyed.
+        template <typename char_type>
+        struct small_string_table
+        {
+            inline static std::atomic<heap_string*> strings[0x80]{};
+
+            static heap_string* get(char_type value) noexcept
+            {
+                XLANG_ASSERT(static_cast<uint32_t>(value) < 0x80);
+                auto& entry = strings[static_cast<uint32_t>(value)];
+
+                if (auto result = entry.load(std::memory_order_acquire))
+                {
+                    return result;
+                }
+
+                heap_string* result{};
+
+                try
+                {
+                    result = heap_string::create_interned(&value, 1);
+                }
+                catch (...)
+                {
+                    return nullptr;
+                }
+
+                heap_string* expected{};
+
+                if (!entry.compare_exchange_strong(expected, result, std::memory_order_acq_rel))
+                {
+                    // Another thread won the race to create the string.
+                    result->release();
+                    return expected;
+                }
+
+                return result;
+            }
+        };
+    }
+
+    heap_string* get_small_string(xlang_char8 value) noexcept
+    {
+        return small_string_table<xlang_char8>::get(value);
+    }
+
+    heap_string* get_small_string(char16_t value) noexcept
+    {
+        return small_string_table<char16_t>::get(value);
+    }
+}
@@ -0,0 +1,25 @@
+#pragma once
+
+#include "pal.h"
+
+namespace xlang::impl
+{
+    struct heap_string;
+
+    heap_string* get_small_string(xlang_char8 value) noexcept;
+    heap_string* get_small_string(char16_t value) noexcept;
+
+    // Strings of a single ASCII character come from a shared table of immortal strings, created on first use, so
+    // that creating, duplicating or deleting one never allocates. Returns nullptr for any other string, or if the
+    // table's string could not be created.
+    template <typename char_type>
+    inline heap_string* find_small_string(char_type const* source_string, uint32_t length) noexcept
+    {
+        if (length == 1 && static_cast<uint32_t>(source_string[0]) < 0x80)
+        {
+            return get_small_string(source_string[0]);
+        }
+
+        return nullptr;
+    }
+}
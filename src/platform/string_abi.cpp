@@ -1,5 +1,6 @@
 #include "opaque_string_wrapper.h"
 #include "string_reference.h"
+#include "interned_string.h"
 #include "pal_error.h"
 
 // Define the ABI-level implementations of string methods
@@ -37,6 +38,21 @@ namespace xlang::impl
         return nullptr;
     }
 
+    template <typename char_type>
+    xlang_string create_interned_string(char_type const* source_string, uint32_t length)
+    {
+        if (!source_string && length != 0)
+        {
+            xlang::throw_result(xlang_result::pointer);
+        }
+
+        if (length != 0)
+        {
+            return to_handle(intern_string(std::basic_string_view<char_type>{ source_string, length }));
+        }
+        return nullptr;
+    }
+
     template <typename char_type>
     xlang_string create_string_reference(
         char_type const* source_string,
@@ -163,6 +179,38 @@ catch (...)
     return xlang::to_result();
 }
 
+XLANG_PAL_EXPORT xlang_error_info* XLANG_CALL xlang_create_interned_string_utf8(
+    xlang_char8 const* source_string,
+    uint32_t length,
+    xlang_string* string
+) XLANG_NOEXCEPT
+try
+{
+    *string = xlang::impl::create_interned_string(source_string, length);
+    return nullptr;
+}
+catch (...)
+{
+    *string = nullptr;
+    return xlang::to_result();
+}
+
+XLANG_PAL_EXPORT xlang_error_info* XLANG_CALL xlang_create_interned_string_utf16(
+    char16_t const* source_string,
+    uint32_t length,
+    xlang_string* string
+) XLANG_NOEXCEPT
+try
+{
+    *string = xlang::impl::create_interned_string(source_string, length);
+    return nullptr;
+}
+catch (...)
+{
+    *string = nullptr;
+    return xlang::to_result();
+}
+
 XLANG_PAL_EXPORT void XLANG_CALL xlang_delete_string(xlang_string string) XLANG_NOEXCEPT
 {
     string_base* str = from_handle(string);
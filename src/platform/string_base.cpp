@@ -6,6 +6,11 @@ namespace xlang::impl
 {
     void string_base::release_base() noexcept
     {
+        if (this->is_interned())
+        {
+            return;
+        }
+
         if (this->is_reference())
         {
             static_cast<string_reference*>(this)->release();
@@ -18,6 +23,11 @@ namespace xlang::impl
 
     string_base* string_base::duplicate_base()
     {
+        if (this->is_interned())
+        {
+            return this;
+        }
+
         if (this->is_reference())
         {
             auto str = static_cast<string_reference*>(this);
@@ -6,6 +6,7 @@
 #include "pal_internal.h"
 #include "cache_string.h"
 #include "string_traits.h"
+#include "pal_statistics.h"
 
 namespace xlang::impl
 {
@@ -14,13 +15,16 @@ namespace xlang::impl
     {
         none = 0x0000,         // None
         is_reference = 0x0001, // Whether this is a "fast" string
+        is_interned = 0x0002,  // Immortal heap string owned by the interned or small string table
         is_utf8 = 0x0020,      // Character pointer is UTF-8 data
+        buffer_pool_class = 0x0F00, // Size class of the string buffer pool block that holds a heap string, or zero if
+                                    // the block did not come from the pool
 
         is_preallocated_string_buffer = 0xF8B10000,
         reserved_for_preallocated_string_buffer = 0xFFFF0000, // Reserved bits that are set to a specifc value if this is a preallocated string buffer.
                                                               // Ensures that the magic value above cannot be coincidentally shared by some
                                                               // valid future combination of string_flags
-        flags_to_preserve_during_promote = is_utf8,           // Some flags should be preserved after promoting a preallocated buffer.
+        flags_to_preserve_during_promote = is_utf8 | buffer_pool_class, // Some flags should be preserved after promoting a preallocated buffer.
     };
 
     constexpr string_flags operator | (string_flags lhs, string_flags rhs) noexcept
@@ -55,7 +59,9 @@ namespace xlang::impl
 
     inline constexpr string_flags all_valid_flags =
         string_flags::is_reference |
+        string_flags::is_interned |
         string_flags::is_utf8 |
+        string_flags::buffer_pool_class |
         string_flags::reserved_for_preallocated_string_buffer;
 
     struct string_storage_base
@@ -95,7 +101,9 @@ namespace xlang::impl
     //          a buffer provided by the caller.
     //
     //      heap_string is a shared, immutable, heap-allocated string instance that packes the
-    //          string header data and character data into a single allocation.
+    //          string header data and character data into a single allocation. Interned heap_strings
+    //          and small strings (a single ASCII character, shared from a table) are never freed, so
+    //          duplicating and deleting them does nothing.
     //
     // cache_string holds is *NOT* a sub-class of string_base.
     //     It holds string buffer data when a raw buffer is requested in a different
@@ -115,9 +123,11 @@ namespace xlang::impl
         char_type const* get_buffer() const noexcept;
 
         bool is_reference() const noexcept;
+        bool is_interned() const noexcept;
         bool is_preallocated_buffer() const noexcept;
         bool is_utf8() const noexcept;
         bool has_alternate() const noexcept;
+        uint32_t get_buffer_pool_class() const noexcept;
 
     protected:
         string_base() = delete;
@@ -133,6 +143,9 @@ namespace xlang::impl
 
         void promote_string_buffer_flags() noexcept;
 
+        void mark_interned() noexcept;
+        void set_buffer_pool_class(uint32_t size_class) noexcept;
+
         // Get or set the alternate representation string, in a thread-safe manner
         template <typename alternate_type>
         alternate_type const* get_alternate_ptr() const noexcept;
@@ -167,6 +180,11 @@ namespace xlang::impl
         return (flags & string_flags::is_reference) != string_flags::none;
     }
 
+    inline bool string_base::is_interned() const noexcept
+    {
+        return (flags & string_flags::is_interned) != string_flags::none;
+    }
+
     inline bool string_base::is_preallocated_buffer() const noexcept
     {
         return (flags & string_flags::reserved_for_preallocated_string_buffer) == string_flags::is_preallocated_string_buffer;
@@ -182,6 +200,11 @@ namespace xlang::impl
         return get_alternate_ptr<cache_string>();
     }
 
+    inline uint32_t string_base::get_buffer_pool_class() const noexcept
+    {
+        return static_cast<uint32_t>(flags & string_flags::buffer_pool_class) >> 8;
+    }
+
     template <typename char_type>
     inline string_base::string_base(char_type const* storage, uint32_t length, string_flags new_flags) noexcept
         : string_storage_base{}
@@ -204,6 +227,18 @@ namespace xlang::impl
         flags = preserved;
     }
 
+    inline void string_base::mark_interned() noexcept
+    {
+        XLANG_ASSERT(!is_reference() && !is_preallocated_buffer());
+        flags |= string_flags::is_interned;
+    }
+
+    inline void string_base::set_buffer_pool_class(uint32_t size_class) noexcept
+    {
+        XLANG_ASSERT(size_class <= (static_cast<uint32_t>(string_flags::buffer_pool_class) >> 8));
+        flags = (flags & ~string_flags::buffer_pool_class) | static_cast<string_flags>(size_class << 8);
+    }
+
     template <typename alternate_type>
     inline alternate_type const* string_base::get_alternate_ptr() const noexcept
     {
@@ -256,6 +291,7 @@ namespace xlang::impl
             if (!alternate)
             {
                 auto new_alternate = cache_string::create(get_buffer<my_char_type>(), get_length());
+                count_string<my_char_type>(&pal_counters::string_counters::conversions);
                 alternate = set_alternate_ptr<cache_string>(new_alternate.get());
                 if (alternate == new_alternate.get())
                 {
@@ -0,0 +1,139 @@
+#include "pal_internal.h"
+#include "string_buffer_pool.h"
+#include "thread_registry.h"
+#include <atomic>
+#include <iterator>
+
+namespace xlang::impl
+{
+    namespace
+    {
+        constexpr size_t class_sizes[]{ 64, 128, 256, 512, 1024, 2048 };
+        static_assert(std::size(class_sizes) == string_buffer_class_count);
+
+        // Each thread caches up to 16KB of blocks in each size class, beyond which freed blocks are returned to
+        // xlang_mem_free.
+        constexpr uint32_t get_cache_limit(uint32_t index) noexcept
+        {
+            return static_cast<uint32_t>((16 * 1024) / class_sizes[index]);
+        }
+
+        struct free_block
+        {
+            free_block* next;
+        };
+
+        // Caches are only used by one thread at a time, so the blocks need no synchronization. The counters are
+        // only written by that thread, but are read by get_string_buffer_pool_statistics on any thread. A cache
+        // outlives its thread, and the blocks it holds are reused by the next thread to adopt it.
+        struct thread_cache
+        {
+            free_block* blocks[string_buffer_class_count]{};
+            uint32_t cached[string_buffer_class_count]{};
+
+            std::atomic<uint64_t> allocations{};
+            std::atomic<uint64_t> reuses{};
+            std::atomic<uint64_t> recycles{};
+            std::atomic<uint64_t> discards{};
+            std::atomic<uint64_t> cached_blocks{};
+        };
+
+        void bump(std::atomic<uint64_t>& counter, int64_t delta = 1) noexcept
+        {
+            counter.store(counter.load(std::memory_order_relaxed) + delta, std::memory_order_relaxed);
+        }
+
+        inline thread_cache* current() noexcept
+        {
+            return thread_registry<thread_cache>::current();
+        }
+    }
+
+    void* allocate_string_buffer(size_t size, uint32_t& size_class)
+    {
+        size_class = 0;
+        auto cache = current();
+
+        if (cache)
+        {
+            bump(cache->allocations);
+        }
+
+        for (uint32_t index = 0; index != string_buffer_class_count; ++index)
+        {
+            if (size > class_sizes[index])
+            {
+                continue;
+            }
+
+            size_class = index + 1;
+
+            if (cache)
+            {
+                if (auto head = cache->blocks[index])
+                {
+                    cache->blocks[index] = head->next;
+                    --cache->cached[index];
+                    bump(cache->cached_blocks, -1);
+                    bump(cache->reuses);
+                    return head;
+                }
+            }
+
+            size = class_sizes[index];
+            break;
+        }
+
+        void* result = xlang_mem_alloc(size);
+
+        if (!result)
+        {
+            throw std::bad_alloc{};
+        }
+
+        return result;
+    }
+
+    void free_string_buffer(void* block, uint32_t size_class) noexcept
+    {
+        if (size_class != 0)
+        {
+            auto const index = size_class - 1;
+            XLANG_ASSERT(index < string_buffer_class_count);
+
+            if (auto cache = current())
+            {
+                if (cache->cached[index] != get_cache_limit(index))
+                {
+                    auto head = static_cast<free_block*>(block);
+                    head->next = cache->blocks[index];
+                    cache->blocks[index] = head;
+                    ++cache->cached[index];
+                    bump(cache->cached_blocks);
+                    bump(cache->recycles);
+                    return;
+                }
+
+                bump(cache->discards);
+            }
+        }
+
+        xlang_mem_free(block);
+    }
+
+    xlang_string_buffer_pool_statistics get_string_buffer_pool_statistics() noexcept
+    {
+        xlang_string_buffer_pool_statistics result{};
+
+        thread_registry<thread_cache>::for_each([&](thread_cache const& cache)
+        {
+            result.allocations += cache.allocations.load(std::memory_order_relaxed);
+            result.reuses += cache.reuses.load(std::memory_order_relaxed);
+            result.recycles += cache.recycles.load(std::memory_order_relaxed);
+            result.discards += cache.discards.load(std::memory_order_relaxed);
+            result.cached_blocks += cache.cached_blocks.load(std::memory_order_relaxed);
+        });
+
+        return result;
+    }
+}
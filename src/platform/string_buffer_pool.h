@@ -0,0 +1,19 @@
+#pragma once
+
+#include "pal.h"
+
+namespace xlang::impl
+{
+    // Preallocated string buffers are recycled through per-thread caches bucketed by block size, since
+    // projections build large numbers of short-lived strings this way. A block comes back to the pool when the
+    // string it became is freed, whether or not the buffer was promoted.
+    //
+    // Returns a block of at least size bytes, along with the size class to pass to free_string_buffer. A size
+    // class of zero means that the block is too large to be pooled and was allocated with xlang_mem_alloc.
+    void* allocate_string_buffer(size_t size, uint32_t& size_class);
+    void free_string_buffer(void* block, uint32_t size_class) noexcept;
+
+    constexpr uint32_t string_buffer_class_count = 6;
+
+    xlang_string_buffer_pool_statistics get_string_buffer_pool_statistics() noexcept;
+}
@@ -1,7 +1,9 @@
 #pragma once
 
 #include "pal.h"
+#include "pal_error.h"
 #include <stdint.h>
+#include <limits>
 #include <optional>
 #include <string_view>
 
@@ -10,6 +12,25 @@ namespace xlang::impl
     uint32_t get_converted_length(std::basic_string_view<char16_t> input_str);
     uint32_t get_converted_length(std::basic_string_view<xlang_char8> input_str);
 
+    // The largest number of code units that converting the string may produce, which allows a string to be
+    // converted in a single pass rather than being measured first.
+    inline uint32_t get_converted_length_bound(std::basic_string_view<char16_t> input_str)
+    {
+        // A UTF-16 code unit encodes as at most three UTF-8 code units, and a surrogate pair as four.
+        auto const bound = uint64_t{ 3 } * input_str.size();
+        if (bound > std::numeric_limits<uint32_t>::max())
+        {
+            throw_result(xlang_result::invalid_arg, "Insufficient buffer size");
+        }
+        return static_cast<uint32_t>(bound);
+    }
+
+    inline uint32_t get_converted_length_bound(std::basic_string_view<xlang_char8> input_str)
+    {
+        // Every UTF-8 sequence is at least as long as its UTF-16 encoding.
+        return static_cast<uint32_t>(input_str.size());
+    }
+
     uint32_t convert_string(
         std::basic_string_view<char16_t> input_str,
         xlang_char8* output_buffer,
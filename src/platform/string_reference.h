@@ -2,6 +2,7 @@
 
 #include "string_base.h"
 #include "cache_string.h"
+#include "pal_statistics.h"
 
 namespace xlang::impl
 {
@@ -47,6 +48,7 @@ namespace xlang::impl
         string_reference* header
     ) noexcept
     {
+        count_string<char_type>(&pal_counters::string_counters::string_references);
         return (new (header) string_reference{ source_string, length });
     }
 
@@ -0,0 +1,124 @@
+#pragma once
+
+#include <mutex>
+#include <new>
+#include <vector>
+
+namespace xlang::impl
+{
+    // Gives each thread its own instance of T, for caches and counters that the owning thread updates without
+    // synchronization. Instances outlive their threads, since what they hold may still matter to other threads,
+    // and are adopted by new threads. The registry is deliberately leaked to remain usable while other static and
+    // thread-local objects are destroyed.
+    template <typename T>
+    struct thread_registry
+    {
+        // Returns null if the thread is exiting or an instance could not be allocated.
+        static T* current() noexcept
+        {
+            if (auto value = current_value)
+            {
+                return value;
+            }
+
+            return exiting ? nullptr : adopt();
+        }
+
+        // Calls the function for every instance, including those not currently owned by a thread.
+        template <typename F>
+        static void for_each(F&& f)
+        {
+            auto& state = get_state();
+            std::lock_guard<std::mutex> guard{ state.lock };
+
+            for (auto value : state.all)
+            {
+                f(*value);
+            }
+        }
+
+    private:
+
+        struct state
+        {
+            std::mutex lock;
+            std::vector<T*> all;
+            std::vector<T*> idle;
+        };
+
+        static state& get_state() noexcept
+        {
+            static state* value = new state;
+            return *value;
+        }
+
+        // Returns the thread's instance to the registry when the thread exits.
+        struct thread_handle
+        {
+            T* value{};
+
+            ~thread_handle() noexcept
+            {
+                current_value = nullptr;
+                exiting = true;
+
+                if (value)
+                {
+                    auto& state = get_state();
+                    std::lock_guard<std::mutex> guard{ state.lock };
+                    state.idle.push_back(value);
+                }
+            }
+        };
+
+        static T* acquire() noexcept
+        {
+            auto& state = get_state();
+            std::lock_guard<std::mutex> guard{ state.lock };
+
+            if (!state.idle.empty())
+            {
+                auto result = state.idle.back();
+                state.idle.pop_back();
+                return result;
+            }
+
+            auto result = new (std::nothrow) T;
+
+            if (result)
+            {
+                try
+                {
+                    // Reserving space up front means that returning the instance can never fail.
+                    state.idle.reserve(state.all.size() + 1);
+                    state.all.push_back(result);
+                }
+                catch (...)
+                {
+                    delete result;
+                    return nullptr;
+                }
+            }
+
+            return result;
+        }
+
+        static T* adopt() noexcept
+        {
+            thread_local thread_handle handle;
+
+            if (!handle.value)
+            {
+                handle.value = acquire();
+                current_value = handle.value;
+            }
+
+            return handle.value;
+        }
+
+        // The instance pointer is a trivial thread-local so that the common path avoids the initialization check
+        // that a thread-local with a destructor requires on every access.
+        inline static thread_local T* current_value{};
+        inline static thread_local bool exiting{};
+    };
+}
@@ -66,4 +66,70 @@ namespace xlang::impl
             return try_get_activation_func({ converted_name.get(), converted_length });
         }
     }
+
+    namespace
+    {
+        std::wstring to_wide_path(std::basic_string_view<xlang_char8> path)
+        {
+            std::wstring result(get_converted_length(path), L'\0');
+            static_assert(sizeof(char16_t) == sizeof(wchar_t));
+            convert_string(path, reinterpret_cast<char16_t*>(result.data()), static_cast<uint32_t>(result.size()));
+            return result;
+        }
+
+        struct handle_guard
+        {
+            HANDLE value;
+
+            ~handle_guard() noexcept
+            {
+                if (value && value != INVALID_HANDLE_VALUE)
+                {
+                    ::CloseHandle(value);
+                }
+            }
+        };
+    }
+
+    // Windows binds every import when a library is loaded, so bind_now has no effect.
+    xlang_pfn_lib_get_activation_factory try_load_activation_func(
+        std::basic_string_view<xlang_char8> path,
+        bool /*bind_now*/)
+    {
+        HMODULE module = ::LoadLibraryW(to_wide_path(path).c_str());
+
+        if (module)
+        {
+            return reinterpret_cast<xlang_pfn_lib_get_activation_factory>(::GetProcAddress(module, activation_fn_name.data()));
+        }
+        return nullptr;
+    }
+
+    mapped_file::mapped_file(std::basic_string_view<xlang_char8> path)
+    {
+        handle_guard file{ ::CreateFileW(to_wide_path(path).c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr) };
+        check_bool(file.value != INVALID_HANDLE_VALUE);
+
+        LARGE_INTEGER size{};
+        check_bool(::GetFileSizeEx(file.value, &size));
+
+        // An empty file cannot be mapped, but is simply an empty view.
+        if (size.QuadPart != 0)
+        {
+            handle_guard mapping{ ::CreateFileMappingW(file.value, nullptr, PAGE_READONLY, 0, 0, nullptr) };
+            check_bool(mapping.value);
+
+            m_data = ::MapViewOfFile(mapping.value, FILE_MAP_READ, 0, 0, 0);
+            check_bool(m_data);
+            m_size = static_cast<size_t>(size.QuadPart);
+        }
+    }
+
+    mapped_file::~mapped_file() noexcept
+    {
+        if (m_data)
+        {
+            ::UnmapViewOfFile(m_data);
+        }
+    }
 }
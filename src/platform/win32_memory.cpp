@@ -1,5 +1,6 @@
 #include "pal.h"
 #include <objbase.h>
+#include "memory.h"
 
 #if !XLANG_PLATFORM_WINDOWS
 #error "This file is only for targeting Windows"
@@ -17,3 +18,11 @@ extern "C"
         return ::CoTaskMemFree(ptr);
     }
 }
+
+namespace xlang::impl
+{
+    memory_statistics get_memory_statistics() noexcept
+    {
+        return { allocator_mode::system };
+    }
+}
@@ -0,0 +1,65 @@
+#include "pch.h"
+#include "meta_reader.h"
+#include "text_writer.h"
+
+namespace
+{
+    struct writer : xlang::text::writer_base<writer>
+    {
+    };
+}
+
+TEST_CASE("arena")
+{
+    xlang::arena a;
+    REQUIRE(a.reserved() == 0);
+    REQUIRE(a.copy("").empty());
+    REQUIRE(a.reserved() == 0);
+
+    auto first = a.copy("first");
+    auto second = a.copy("second");
+    REQUIRE(first == "first");
+    REQUIRE(second == "second");
+    REQUIRE(a.reserved() != 0);
+
+    auto aligned = a.allocate(sizeof(double), alignof(double));
+    REQUIRE(reinterpret_cast<std::uintptr_t>(aligned) % alignof(double) == 0);
+
+    // Allocations larger than a chunk get a chunk of their own and leave earlier strings in place.
+    std::string large(64 * 1024, 'x');
+    REQUIRE(a.copy(large) == large);
+    REQUIRE(a.reserved() >= large.size());
+    REQUIRE(first == "first");
+    REQUIRE(second == "second");
+}
+
+TEST_CASE("arena_allocator")
+{
+    xlang::arena a;
+    std::set<int, std::less<int>, xlang::arena_allocator<int>> values{ xlang::arena_allocator<int>{ a } };
+
+    for (int i = 100; i != 0; --i)
+    {
+        values.insert(i);
+    }
+
+    REQUIRE(values.size() == 100);
+    REQUIRE(*values.begin() == 1);
+    REQUIRE(a.reserved() != 0);
+
+    std::vector<int, xlang::arena_allocator<int>> heap;
+    heap.assign(values.begin(), values.end());
+    REQUIRE(heap.get_allocator().get_arena() == nullptr);
+    REQUIRE(heap.get_allocator() != values.get_allocator());
+    REQUIRE(heap.back() == 100);
+}
+
+TEST_CASE("writer_transient")
+{
+    writer w;
+    auto name = w.write_transient("%.%", "Windows", "Foundation");
+    w.write("body");
+    REQUIRE(name == "Windows.Foundation");
+    REQUIRE(w.flush_to_string() == "body");
+    REQUIRE(w.transient_arena().reserved() != 0);
+}
@@ -0,0 +1,77 @@
+#include "pch.h"
+#include "meta_reader.h"
+#include "text_writer.h"
+
+namespace
+{
+    struct writer : xlang::text::writer_base<writer>
+    {
+    };
+
+    std::string read_file(std::filesystem::path const& filename)
+    {
+        std::ifstream file{ filename, std::ios::in | std::ios::binary };
+        return { std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>() };
+    }
+}
+
+TEST_CASE("output_sink")
+{
+    auto folder = std::filesystem::temp_directory_path() / "xlang_test_output_sink";
+    std::filesystem::create_directories(folder);
+
+    {
+        xlang::text::output_sink sink;
+        REQUIRE(xlang::text::output_sink::current() == &sink);
+
+        for (int32_t i = 0; i < 16; ++i)
+        {
+            writer w;
+            w.write("body %", i);
+            w.swap();
+            w.write("head ");
+            w.flush_to_file(folder / (std::to_string(i) + ".txt"));
+        }
+
+        sink.get();
+    }
+
+    REQUIRE(xlang::text::output_sink::current() == nullptr);
+
+    for (int32_t i = 0; i < 16; ++i)
+    {
+        REQUIRE(read_file(folder / (std::to_string(i) + ".txt")) == "head body " + std::to_string(i));
+    }
+
+    std::filesystem::remove_all(folder);
+}
+
+TEST_CASE("output_sink per thread")
+{
+    xlang::text::output_sink sink;
+    xlang::text::output_sink* task_sink{};
+    xlang::text::output_sink* thread_sink{};
+    xlang::text::output_sink* thread_task_sink{};
+
+    {
+        xlang::task_group group;
+        group.add([&] { task_sink = xlang::text::output_sink::current(); });
+        group.get();
+    }
+
+    std::thread thread([&]
+    {
+        xlang::text::output_sink other;
+        thread_sink = xlang::text::output_sink::current();
+        xlang::task_group group;
+        group.add([&] { thread_task_sink = xlang::text::output_sink::current(); });
+        group.get();
+    });
+
+    thread.join();
+    REQUIRE(task_sink == &sink);
+    REQUIRE(thread_sink != nullptr);
+    REQUIRE(thread_sink != &sink);
+    REQUIRE(thread_task_sink == thread_sink);
+    REQUIRE(xlang::text::output_sink::current() == &sink);
+}
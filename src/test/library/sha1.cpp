@@ -0,0 +1,119 @@
+#include "pch.h"
+#include "../../tool/abi/sha1.h"
+
+namespace
+{
+    std::string to_hex(std::array<std::uint8_t, 20> const& hash)
+    {
+        std::string result;
+
+        for (auto value : hash)
+        {
+            char buffer[3];
+            std::snprintf(buffer, sizeof(buffer), "%02x", value);
+            result += buffer;
+        }
+
+        return result;
+    }
+
+    std::string hash(std::string_view const& value)
+    {
+        sha1 hash;
+        hash.append(value);
+        return to_hex(hash.finalize());
+    }
+
+    // Appends a byte at a time since the string can't be reinterpreted as bytes in a constant expression
+    constexpr std::array<std::uint8_t, 20> constexpr_hash(std::string_view const& value)
+    {
+        sha1 hash;
+
+        for (auto c : value)
+        {
+            auto byte = static_cast<std::uint8_t>(c);
+            hash.append(&byte, 1);
+        }
+
+        return hash.finalize();
+    }
+
+    constexpr bool constexpr_equal(std::array<std::uint8_t, 20> const& left, std::array<std::uint8_t, 20> const& right)
+    {
+        for (std::size_t i = 0; i < left.size(); ++i)
+        {
+            if (left[i] != right[i])
+            {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    static_assert(constexpr_equal(constexpr_hash("abc"),
+    {
+        0xa9, 0x99, 0x3e, 0x36, 0x47, 0x06, 0x81, 0x6a, 0xba, 0x3e,
+        0x25, 0x71, 0x78, 0x50, 0xc2, 0x6c, 0x9c, 0xd0, 0xd8, 0x9d
+    }));
+
+    // A parameterized interface signature, as hashed by the abi tool to generate IIDs
+    constexpr std::string_view signature = "pinterface({913337e9-11a1-4345-a3a2-4e7f956e222d};"
+        "pinterface({b5d036d7-e297-498f-ba60-0289e76e23dd};struct(Windows.Foundation.Point;f4;f4));"
+        "cinterface(IInspectable))";
+}
+
+TEST_CASE("sha1")
+{
+    REQUIRE(hash("") == "da39a3ee5e6b4b0d3255bfef95601890afd80709");
+    REQUIRE(hash("abc") == "a9993e364706816aba3e25717850c26c9cd0d89d");
+    REQUIRE(hash("abcdbcdecdefdefgefghfghighijhijkijkljklmklmnlmnomnopnopq") == "84983e441c3bd26ebaae4aa1f95129e5e54670f1");
+    REQUIRE(hash(std::string(1000000, 'a')) == "34aa973cd4c4daa4f61eeb2bdbad27316534016f");
+}
+
+TEST_CASE("sha1 appends")
+{
+    // Compare runtime hashing, which uses the SHA extensions where available, against compile time hashing over
+    // every split of the input across two appends
+    static constexpr auto expected = constexpr_hash(signature);
+    INFO("hardware accelerated: " << sha1::hardware_accelerated());
+
+    for (std::size_t split = 0; split <= signature.size(); ++split)
+    {
+        sha1 hash;
+        hash.append(signature.substr(0, split));
+        hash.append(signature.substr(split));
+        REQUIRE(hash.finalize() == expected);
+    }
+
+    // Hashing may be resumed after finalize
+    sha1 hash;
+    hash.append("ignored");
+    hash.finalize();
+    hash.append(signature);
+    REQUIRE(hash.finalize() == expected);
+}
+
+TEST_CASE("sha1 benchmark", "[.][benchmark]")
+{
+    std::vector<std::string> signatures;
+
+    for (std::size_t i = 0; i < 4096; ++i)
+    {
+        signatures.push_back(std::string{ signature } + std::to_string(i));
+    }
+
+    BENCHMARK("generic IIDs")
+    {
+        std::uint8_t result{};
+
+        for (auto&& value : signatures)
+        {
+            sha1 hash;
+            hash.append(value);
+            result ^= hash.finalize()[0];
+        }
+
+        return result;
+    };
+}
@@ -0,0 +1,81 @@
+#include "pch.h"
+#include "meta_reader.h"
+#include "task_group.h"
+
+TEST_CASE("task_group")
+{
+    std::atomic<uint32_t> count{};
+    std::mutex lock;
+    std::map<std::thread::id, uint32_t> running;
+    std::size_t max_running{};
+
+    // Records the threads that are running tasks at the same time, counting the thread that adds the tasks as well.
+    auto enter = [&]
+    {
+        std::lock_guard<std::mutex> guard{ lock };
+        ++running[std::this_thread::get_id()];
+        max_running = (std::max)(max_running, running.size());
+    };
+
+    auto leave = [&]
+    {
+        std::lock_guard<std::mutex> guard{ lock };
+        auto found = running.find(std::this_thread::get_id());
+
+        if (--found->second == 0)
+        {
+            running.erase(found);
+        }
+    };
+
+    {
+        xlang::task_group outer;
+
+        // Nested far beyond the number of tasks that run concurrently, so that most of them run inline.
+        for (uint32_t i = 0; i < 64; ++i)
+        {
+            outer.add([&]
+            {
+                enter();
+                xlang::task_group inner;
+
+                for (uint32_t j = 0; j < 64; ++j)
+                {
+                    inner.add([&]
+                    {
+                        enter();
+                        ++count;
+                        std::this_thread::yield();
+                        leave();
+                    });
+                }
+
+                inner.get();
+                leave();
+            });
+        }
+
+        outer.get();
+    }
+
+    REQUIRE(count == 64 * 64);
+    REQUIRE(max_running <= (std::max)(std::thread::hardware_concurrency(), 2u) * 2 + 1);
+}
+
+TEST_CASE("task_group exceptions")
+{
+    xlang::task_group group;
+
+    for (uint32_t i = 0; i < 256; ++i)
+    {
+        group.add([i]
+        {
+            if (i == 200)
+            {
+                throw std::invalid_argument("task");
+            }
+        });
+    }
+
+    REQUIRE_THROWS_AS(group.get(), std::invalid_argument);
+}
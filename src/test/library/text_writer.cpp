@@ -1,12 +1,35 @@
 #include "pch.h"
 #include "meta_reader.h"
 #include "text_writer.h"
+#include <numeric>
 
 namespace
 {
     struct writer : xlang::text::writer_base<writer>
     {
     };
+
+    struct fragment_writer : xlang::text::writer_base<fragment_writer>
+    {
+        std::string prefix;
+        std::set<int32_t> seen;
+
+        void fork(fragment_writer& fragment) const
+        {
+            fragment.prefix = prefix;
+        }
+
+        void merge(fragment_writer const& fragment)
+        {
+            seen.insert(fragment.seen.begin(), fragment.seen.end());
+        }
+    };
+
+    void write_item(fragment_writer& w, int32_t value)
+    {
+        w.write("%% ", w.prefix, value);
+        w.seen.insert(value);
+    }
 }
 
 TEST_CASE("writer")
@@ -18,3 +41,22 @@ TEST_CASE("writer")
 
     REQUIRE(w.flush_to_string() == "pre 123 % String post");
 }
+
+TEST_CASE("writer_each_parallel")
+{
+    std::vector<int32_t> values(100);
+    std::iota(values.begin(), values.end(), 0);
+    std::string expected;
+
+    for (auto value : values)
+    {
+        expected += "#" + std::to_string(value) + " ";
+    }
+
+    fragment_writer w;
+    w.prefix = "#";
+    w.write_each_parallel<write_item>(values);
+
+    REQUIRE(w.flush_to_string() == expected);
+    REQUIRE(w.seen.size() == values.size());
+}
@@ -1,5 +1,12 @@
 #include "pch.h"
 
+#if XLANG_PLATFORM_WINDOWS
+#include <direct.h>
+#else
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
 TEST_CASE("Simple activation")
 {
     xlang_error_info* result{};
@@ -27,3 +34,215 @@ TEST_CASE("Simple activation")
         factory = nullptr;
     }
 }
+
+TEST_CASE("Cached activation")
+{
+    std::u16string_view class_name{ u"AbiComponent.Widget" };
+    xlang_string_header str_header{};
+    xlang_string str{};
+    REQUIRE(xlang_create_string_reference_utf16(class_name.data(), static_cast<uint32_t>(class_name.size()), &str_header, &str) == nullptr);
+
+    xlang_clear_activation_factory_cache();
+
+    xlang_unknown* first{};
+    xlang_unknown* second{};
+    REQUIRE(xlang_get_activation_factory(str, xlang_unknown_guid, reinterpret_cast<void**>(&first)) == nullptr);
+    REQUIRE(xlang_get_activation_factory(str, xlang_unknown_guid, reinterpret_cast<void**>(&second)) == nullptr);
+    REQUIRE(first != nullptr);
+    REQUIRE(first == second);
+    second->Release();
+
+    // Clearing the cache releases its reference, but not the caller's.
+    xlang_clear_activation_factory_cache();
+    REQUIRE(xlang_get_activation_factory(str, xlang_unknown_guid, reinterpret_cast<void**>(&second)) == nullptr);
+    REQUIRE(second != nullptr);
+    REQUIRE(second != first);
+    first->Release();
+    second->Release();
+
+    xlang_clear_activation_factory_cache();
+}
+
+TEST_CASE("Failed activation")
+{
+    std::u16string_view class_name{ u"NoSuchComponent.Inner.Widget" };
+    xlang_string_header str_header{};
+    xlang_string str{};
+    REQUIRE(xlang_create_string_reference_utf16(class_name.data(), static_cast<uint32_t>(class_name.size()), &str_header, &str) == nullptr);
+
+    // The second attempt is answered from the cache without looking for the modules again.
+    for (int i = 0; i < 2; ++i)
+    {
+        xlang_unknown* factory{};
+        xlang_error_info* result = xlang_get_activation_factory(str, xlang_unknown_guid, reinterpret_cast<void**>(&factory));
+        REQUIRE(result != nullptr);
+        REQUIRE(factory == nullptr);
+
+        xlang_result error{};
+        result->GetError(&error);
+        REQUIRE(error == xlang_result::type_load);
+        result->Release();
+    }
+
+    xlang_clear_activation_factory_cache();
+}
+
+namespace
+{
+#if XLANG_PLATFORM_WINDOWS
+    constexpr std::string_view component_library{ "AbiComponent.dll" };
+#else
+    constexpr std::string_view component_library{ "libAbiComponent.so" };
+#endif
+
+    xlang_error_info* load_manifest(
+        std::string_view contents,
+        xlang_activation_manifest_options options,
+        std::string_view path = "activation_manifest_test.json")
+    {
+        FILE* file = fopen(path.data(), "wb");
+        REQUIRE(file != nullptr);
+        REQUIRE(fwrite(contents.data(), 1, contents.size(), file) == contents.size());
+        fclose(file);
+
+        xlang_string str{};
+        REQUIRE(xlang_create_string_utf8(path.data(), static_cast<uint32_t>(path.size()), &str) == nullptr);
+        xlang_error_info* result = xlang_load_activation_manifest(str, options);
+        xlang_delete_string(str);
+        remove(path.data());
+        return result;
+    }
+
+    xlang_result activate(std::u16string_view class_name)
+    {
+        xlang_string_header str_header{};
+        xlang_string str{};
+        REQUIRE(xlang_create_string_reference_utf16(class_name.data(), static_cast<uint32_t>(class_name.size()), &str_header, &str) == nullptr);
+
+        xlang_unknown* factory{};
+        xlang_result error{};
+
+        if (xlang_error_info* result = xlang_get_activation_factory(str, xlang_unknown_guid, reinterpret_cast<void**>(&factory)))
+        {
+            REQUIRE(factory == nullptr);
+            result->GetError(&error);
+            result->Release();
+        }
+        else
+        {
+            REQUIRE(factory != nullptr);
+            factory->Release();
+        }
+
+        return error;
+    }
+}
+
+TEST_CASE("Activation manifest")
+{
+    std::string const manifest = "{ \"AbiComponent.Widget\" : \"" + std::string{ component_library } + "\",\n"
+        "  \"Other\\u002eWidget\": \"no_such_library\" }";
+
+    SECTION("Listed classes")
+    {
+        REQUIRE(load_manifest(manifest, xlang_activation_manifest_options::bind_now) == nullptr);
+        REQUIRE(activate(u"AbiComponent.Widget") == xlang_result::success);
+        REQUIRE(activate(u"Other.Widget") == xlang_result::type_load);
+    }
+
+    SECTION("Relative paths")
+    {
+        // The library is in the current directory, which is the parent of the manifest's.
+        constexpr char directory[]{ "activation_manifest_test" };
+#if XLANG_PLATFORM_WINDOWS
+        _mkdir(directory);
+#else
+        mkdir(directory, 0755);
+#endif
+
+        std::string const relative = "{ \"AbiComponent.Widget\": \"../" + std::string{ component_library } + "\" }";
+        xlang_error_info* result = load_manifest(relative, xlang_activation_manifest_options::preload,
+            "activation_manifest_test/manifest.json");
+
+#if XLANG_PLATFORM_WINDOWS
+        _rmdir(directory);
+#else
+        rmdir(directory);
+#endif
+
+        REQUIRE(result == nullptr);
+        REQUIRE(activate(u"AbiComponent.Widget") == xlang_result::success);
+    }
+
+    SECTION("Unlisted classes are probed")
+    {
+        std::string const other = "{ \"Other.Widget\": \"" + std::string{ component_library } + "\" }";
+        REQUIRE(load_manifest(other, xlang_activation_manifest_options::none) == nullptr);
+        REQUIRE(activate(u"AbiComponent.Widget") == xlang_result::success);
+    }
+
+    SECTION("Exclusive manifest")
+    {
+        REQUIRE(load_manifest("{}", xlang_activation_manifest_options::exclusive) == nullptr);
+        REQUIRE(activate(u"AbiComponent.Widget") == xlang_result::type_load);
+    }
+
+    SECTION("Preloading fails for missing libraries")
+    {
+        xlang_error_info* result = load_manifest(manifest, xlang_activation_manifest_options::preload);
+        REQUIRE(result != nullptr);
+        result->Release();
+    }
+
+    SECTION("Invalid manifests")
+    {
+        for (std::string_view const contents : { "", "[]", "{ \"A.B\": 1 }", "{ \"A.B\": \"x\", }", "{ \"A.B\": \"x\" } x",
+            "{ \"A.B\": \"x\", \"A.B\": \"y\" }", "{ \"A\\ud800.B\": \"x\" }", "{ \"\": \"x\" }" })
+        {
+            INFO(contents);
+            xlang_error_info* result = load_manifest(contents, xlang_activation_manifest_options::none);
+            REQUIRE(result != nullptr);
+
+            xlang_result error{};
+            result->GetError(&error);
+            REQUIRE(error == xlang_result::invalid_arg);
+            result->Release();
+        }
+    }
+
+    REQUIRE(xlang_load_activation_manifest(nullptr, xlang_activation_manifest_options::none) == nullptr);
+    REQUIRE(activate(u"AbiComponent.Widget") == xlang_result::success);
+}
+
+// Run by ctest with XLANG_PAL_ACTIVATION_MANIFEST naming a file that does not exist, before any other activation.
+TEST_CASE("Activation manifest from a missing file", "[.][manifest_env]")
+{
+    REQUIRE(activate(u"AbiComponent.Widget") == xlang_result::invalid_arg);
+    REQUIRE(activate(u"AbiComponent.Widget") == xlang_result::success);
+    xlang_clear_activation_factory_cache();
+}
+
+TEST_CASE("Activation benchmark", "[.][benchmark]")
+{
+    std::u16string_view class_name{ u"AbiComponent.Widget" };
+    xlang_string_header str_header{};
+    xlang_string str{};
+    REQUIRE(xlang_create_string_reference_utf16(class_name.data(), static_cast<uint32_t>(class_name.size()), &str_header, &str) == nullptr);
+
+    BENCHMARK("Cached")
+    {
+        xlang_unknown* factory{};
+        xlang_get_activation_factory(str, xlang_unknown_guid, reinterpret_cast<void**>(&factory));
+        return factory->Release();
+    };
+
+    BENCHMARK("Uncached")
+    {
+        xlang_clear_activation_factory_cache();
+        xlang_unknown* factory{};
+        xlang_get_activation_factory(str, xlang_unknown_guid, reinterpret_cast<void**>(&factory));
+        return factory->Release();
+    };
+
+    xlang_clear_activation_factory_cache();
+}
@@ -211,4 +211,85 @@ TEST_CASE("Error origination with all parameters")
     propagated_error = nullptr;
     REQUIRE(result->Release() == 0);
     result = nullptr;
-}
\ No newline at end of file
+}
+
+TEST_CASE("Error origination with only result")
+{
+    for (auto const error : { xlang_result::access_denied, xlang_result::invalid_arg, xlang_result::type_load })
+    {
+        xlang_error_info* first = xlang_originate_error(error);
+        xlang_error_info* second = xlang_originate_error(error);
+        REQUIRE(first != nullptr);
+        REQUIRE(first == second);
+        verify_error_info(first, error);
+
+        // Shared errors record no propagation.
+        xlang_string_header header{};
+        xlang_string projection_identifier{};
+        REQUIRE(xlang_create_string_reference_utf8("python", 6, &header, &projection_identifier) == nullptr);
+        first->PropagateError(projection_identifier, nullptr, nullptr, nullptr);
+        verify_error_info(second, error);
+
+        REQUIRE(first->Release() != 0);
+        REQUIRE(second->Release() != 0);
+    }
+
+    xlang_error_info* access_denied = xlang_originate_error(xlang_result::access_denied);
+    xlang_error_info* type_load = xlang_originate_error(xlang_result::type_load);
+    REQUIRE(access_denied != type_load);
+    access_denied->Release();
+    type_load->Release();
+}
+
+TEST_CASE("Error origination with a string reference message")
+{
+    std::string text{ "This is an error" };
+    xlang_string_header header{};
+    xlang_string message{};
+    REQUIRE(xlang_create_string_reference_utf8(text.c_str(), static_cast<uint32_t>(text.size()), &header, &message) == nullptr);
+
+    xlang_error_info* result = xlang_originate_error(xlang_result::fail, message);
+    xlang_error_info* shared = xlang_originate_error(xlang_result::fail);
+    REQUIRE(result != shared);
+    shared->Release();
+
+    // The error keeps a copy of a string reference, since the reference's buffer may not outlive it.
+    std::fill(text.begin(), text.end(), 'x');
+    xlang_string copied{};
+    result->GetMessage(&copied);
+    REQUIRE(copied != message);
+
+    xlang_char8 const* buffer{};
+    uint32_t length{};
+    REQUIRE(xlang_get_string_raw_buffer_utf8(copied, &buffer, &length) == nullptr);
+    REQUIRE(basic_string_view<xlang_char8>{ buffer, length } == "This is an error");
+
+    xlang_delete_string(copied);
+    REQUIRE(result->Release() == 0);
+}
+
+TEST_CASE("Error origination benchmark", "[.][benchmark]")
+{
+    xlang_string message{};
+    REQUIRE(xlang_create_string_utf8("This is an error", 16, &message) == nullptr);
+    xlang_string_header header{};
+    xlang_string reference{};
+    REQUIRE(xlang_create_string_reference_utf8("This is an error", 16, &header, &reference) == nullptr);
+
+    BENCHMARK("Result only")
+    {
+        return xlang_originate_error(xlang_result::type_load)->Release();
+    };
+
+    BENCHMARK("Heap string message")
+    {
+        return xlang_originate_error(xlang_result::type_load, message)->Release();
+    };
+
+    BENCHMARK("String reference message")
+    {
+        return xlang_originate_error(xlang_result::type_load, reference)->Release();
+    };
+
+    xlang_delete_string(message);
+}
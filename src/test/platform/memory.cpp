@@ -57,3 +57,175 @@ TEST_CASE("Mem alloc")
         // This will also check xlang_mem_free with null
     }
 }
+
+TEST_CASE("Mem alloc reuse")
+{
+    SECTION("Alignment")
+    {
+        for (size_t size : { 1, 8, 17, 64, 255, 256, 257, 4096 })
+        {
+            MemGuard ptr{ xlang_mem_alloc(size) };
+            REQUIRE(ptr.m_ptr != nullptr);
+            REQUIRE(reinterpret_cast<uintptr_t>(ptr.m_ptr) % alignof(std::max_align_t) == 0);
+            std::fill_n(static_cast<char*>(ptr.m_ptr), size, 'a');
+        }
+    }
+    SECTION("Distinct live blocks")
+    {
+        std::vector<void*> blocks;
+
+        for (size_t i = 0; i < 1024; ++i)
+        {
+            blocks.push_back(xlang_mem_alloc(1 + i % 300));
+            REQUIRE(blocks.back() != nullptr);
+            *static_cast<size_t*>(blocks.back()) = i;
+        }
+
+        for (size_t i = 0; i < blocks.size(); ++i)
+        {
+            REQUIRE(*static_cast<size_t*>(blocks[i]) == i);
+            xlang_mem_free(blocks[i]);
+        }
+    }
+    SECTION("Free on another thread")
+    {
+        std::vector<void*> blocks;
+
+        for (size_t i = 0; i < 256; ++i)
+        {
+            blocks.push_back(xlang_mem_alloc(1 + i % 300));
+        }
+
+        std::thread{ [&]
+        {
+            for (auto block : blocks)
+            {
+                xlang_mem_free(block);
+            }
+        } }.join();
+
+        // Blocks freed remotely are reclaimed by this thread without disturbing new allocations.
+        for (auto&& block : blocks)
+        {
+            block = xlang_mem_alloc(32);
+            REQUIRE(block != nullptr);
+            std::fill_n(static_cast<char*>(block), 32, 'b');
+        }
+
+        for (auto block : blocks)
+        {
+            xlang_mem_free(block);
+        }
+    }
+}
+
+TEST_CASE("Mem alloc during thread exit")
+{
+    static std::atomic<bool> succeeded;
+    succeeded = false;
+
+    struct exit_allocator
+    {
+        ~exit_allocator()
+        {
+            void* ptr = xlang_mem_alloc(64);
+
+            if (ptr)
+            {
+                std::fill_n(static_cast<char*>(ptr), 64, 'a');
+                xlang_mem_free(ptr);
+                succeeded = true;
+            }
+        }
+    };
+
+    std::thread{ []
+    {
+        // Constructed before the thread's first allocation, so it is destroyed after any per-thread state that the
+        // allocator keeps.
+        static thread_local exit_allocator value;
+        (void)value;
+        xlang_mem_free(xlang_mem_alloc(64));
+    } }.join();
+
+    REQUIRE(succeeded);
+}
+
+static std::vector<std::string> const& storm_values()
+{
+    static std::vector<std::string> const values = []
+    {
+        std::vector<std::string> result;
+
+        for (size_t i = 0; i < 4096; ++i)
+        {
+            result.push_back("Windows.Foundation.IAsyncOperation`" + std::to_string(i));
+        }
+
+        return result;
+    }();
+
+    return values;
+}
+
+static void string_storm(size_t count)
+{
+    auto const& values = storm_values();
+    std::vector<xlang_string> strings(count);
+    std::vector<xlang_string> duplicates(count);
+
+    for (size_t i = 0; i < count; ++i)
+    {
+        xlang_create_string_utf8(values[i].data(), static_cast<uint32_t>(values[i].size()), &strings[i]);
+        xlang_duplicate_string(strings[i], &duplicates[i]);
+    }
+
+    for (size_t i = 0; i < count; ++i)
+    {
+        xlang_delete_string(strings[i]);
+        xlang_delete_string(duplicates[i]);
+    }
+}
+
+TEST_CASE("Mem alloc benchmark", "[.][benchmark]")
+{
+    auto const& values = storm_values();
+
+    BENCHMARK("string create/duplicate/delete")
+    {
+        string_storm(values.size());
+    };
+
+    BENCHMARK("string create/duplicate/delete on 4 threads")
+    {
+        std::vector<std::thread> threads;
+
+        for (int i = 0; i < 4; ++i)
+        {
+            threads.emplace_back(string_storm, values.size() / 4);
+        }
+
+        for (auto&& thread : threads)
+        {
+            thread.join();
+        }
+    };
+
+    BENCHMARK("strings deleted on another thread")
+    {
+        std::vector<xlang_string> strings(values.size());
+
+        for (size_t i = 0; i < strings.size(); ++i)
+        {
+            xlang_create_string_utf8(values[i].data(), static_cast<uint32_t>(values[i].size()), &strings[i]);
+        }
+
+        std::thread{ [&]
+        {
+            for (auto value : strings)
+            {
+                xlang_delete_string(value);
+            }
+        } }.join();
+    };
+}
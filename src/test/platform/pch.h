@@ -5,8 +5,11 @@
 #include <pal.h>
 
 #include <algorithm>
+#include <atomic>
 #include <limits>
 #include <string_view>
+#include <thread>
+#include <vector>
 
 #if XLANG_PLATFORM_WINDOWS
 #include <winrt/base.h>
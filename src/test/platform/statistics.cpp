@@ -0,0 +1,177 @@
+#include "pch.h"
+#include "string_helpers.h"
+
+namespace
+{
+    xlang_pal_statistics get_statistics()
+    {
+        xlang_pal_statistics result{};
+        xlang_get_pal_statistics(&result);
+        return result;
+    }
+}
+
+TEST_CASE("String statistics")
+{
+    constexpr std::u16string_view value{ u"Windows.Foundation" };
+    auto const before = get_statistics();
+
+    xlang_string str{};
+    REQUIRE(xlang_create_string_utf16(value.data(), static_cast<uint32_t>(value.size()), &str) == nullptr);
+
+    auto after = get_statistics();
+    REQUIRE(after.utf16_strings.live_heap_strings == before.utf16_strings.live_heap_strings + 1);
+    REQUIRE(after.utf16_strings.total_heap_strings == before.utf16_strings.total_heap_strings + 1);
+    REQUIRE(after.utf16_strings.heap_string_bytes > before.utf16_strings.heap_string_bytes + value.size() * sizeof(char16_t));
+    REQUIRE(after.utf8_strings.live_heap_strings == before.utf8_strings.live_heap_strings);
+
+    xlang_char8 const* buffer{};
+    uint32_t length{};
+    REQUIRE(xlang_get_string_raw_buffer_utf8(str, &buffer, &length) == nullptr);
+    REQUIRE(xlang_get_string_raw_buffer_utf8(str, &buffer, &length) == nullptr);
+
+    after = get_statistics();
+    REQUIRE(after.utf16_strings.conversions == before.utf16_strings.conversions + 1);
+
+    xlang_delete_string(str);
+
+    after = get_statistics();
+    REQUIRE(after.utf16_strings.live_heap_strings == before.utf16_strings.live_heap_strings);
+    REQUIRE(after.utf16_strings.heap_string_bytes == before.utf16_strings.heap_string_bytes);
+    REQUIRE(after.utf16_strings.total_heap_strings == before.utf16_strings.total_heap_strings + 1);
+
+    xlang_string_header header{};
+    REQUIRE(xlang_create_string_reference_utf16(value.data(), static_cast<uint32_t>(value.size()), &header, &str) == nullptr);
+    xlang_delete_string(str);
+
+    after = get_statistics();
+    REQUIRE(after.utf16_strings.string_references == before.utf16_strings.string_references + 1);
+    REQUIRE(after.utf16_strings.live_heap_strings == before.utf16_strings.live_heap_strings);
+}
+
+TEST_CASE("String buffer statistics")
+{
+    auto const before = get_statistics();
+
+    xlang_string_buffer buffer_handle{};
+    xlang_char8* buffer{};
+    REQUIRE(xlang_preallocate_string_buffer_utf8(100, &buffer, &buffer_handle) == nullptr);
+    std::fill(buffer, buffer + 10, 'a');
+
+    xlang_string str{};
+    REQUIRE(xlang_promote_string_buffer(buffer_handle, &str, 10) == nullptr);
+
+    auto after = get_statistics();
+    REQUIRE(after.utf8_strings.live_heap_strings == before.utf8_strings.live_heap_strings + 1);
+    REQUIRE(after.string_buffer_pool.allocations == before.string_buffer_pool.allocations + 1);
+
+    xlang_delete_string(str);
+
+    after = get_statistics();
+    REQUIRE(after.utf8_strings.live_heap_strings == before.utf8_strings.live_heap_strings);
+    REQUIRE(after.utf8_strings.heap_string_bytes == before.utf8_strings.heap_string_bytes);
+}
+
+TEST_CASE("Error statistics")
+{
+    xlang_string message{};
+    REQUIRE(xlang_create_string_utf8("message", 7, &message) == nullptr);
+
+    auto const before = get_statistics();
+    xlang_error_info* error = xlang_originate_error(xlang_result::invalid_arg, message);
+
+    auto after = get_statistics();
+    REQUIRE(after.total_error_infos == before.total_error_infos + 1);
+    REQUIRE(after.live_error_infos == before.live_error_infos + 1);
+
+    error->Release();
+
+    after = get_statistics();
+    REQUIRE(after.live_error_infos == before.live_error_infos);
+
+    // Errors without a message share a constant error info, so they are counted but never live.
+    error = xlang_originate_error(xlang_result::invalid_arg);
+    error->Release();
+
+    after = get_statistics();
+    REQUIRE(after.total_error_infos == before.total_error_infos + 2);
+    REQUIRE(after.live_error_infos == before.live_error_infos);
+
+    xlang_delete_string(message);
+}
+
+TEST_CASE("Activation statistics")
+{
+    std::u16string_view class_name{ u"AbiComponent.Widget" };
+    xlang_string_header header{};
+    xlang_string str{};
+    REQUIRE(xlang_create_string_reference_utf16(class_name.data(), static_cast<uint32_t>(class_name.size()), &header, &str) == nullptr);
+
+    xlang_clear_activation_factory_cache();
+    auto const before = get_statistics();
+
+    for (int i = 0; i < 3; ++i)
+    {
+        xlang_unknown* factory{};
+        REQUIRE(xlang_get_activation_factory(str, xlang_unknown_guid, reinterpret_cast<void**>(&factory)) == nullptr);
+        factory->Release();
+    }
+
+    auto const after = get_statistics();
+    REQUIRE(after.activation_cache_misses == before.activation_cache_misses + 1);
+    REQUIRE(after.activation_cache_hits == before.activation_cache_hits + 2);
+    REQUIRE(after.activation_module_probes == before.activation_module_probes + 1);
+
+    xlang_clear_activation_factory_cache();
+}
+
+TEST_CASE("Activation statistics without a library")
+{
+    std::u16string_view class_name{ u"NoSuchComponent.Widget" };
+    xlang_string_header header{};
+    xlang_string str{};
+    REQUIRE(xlang_create_string_reference_utf16(class_name.data(), static_cast<uint32_t>(class_name.size()), &header, &str) == nullptr);
+
+    xlang_clear_activation_factory_cache();
+    auto const before = get_statistics();
+
+    // Neither the probe nor the cached failure calls an activation function, so neither counts as a miss.
+    for (int i = 0; i < 2; ++i)
+    {
+        xlang_unknown* factory{};
+        xlang_error_info* result = xlang_get_activation_factory(str, xlang_unknown_guid, reinterpret_cast<void**>(&factory));
+        REQUIRE(result != nullptr);
+        result->Release();
+    }
+
+    auto const after = get_statistics();
+    REQUIRE(after.activation_cache_misses == before.activation_cache_misses);
+    REQUIRE(after.activation_cache_hits == before.activation_cache_hits);
+
+    xlang_clear_activation_factory_cache();
+}
+
+TEST_CASE("Statistics across threads")
+{
+    auto const before = get_statistics();
+    std::vector<xlang_string> strings(100);
+
+    std::thread{ [&]
+    {
+        for (auto&& str : strings)
+        {
+            REQUIRE(xlang_create_string_utf8("created elsewhere", 17, &str) == nullptr);
+        }
+    } }.join();
+
+    auto after = get_statistics();
+    REQUIRE(after.utf8_strings.live_heap_strings == before.utf8_strings.live_heap_strings + strings.size());
+
+    for (auto&& str : strings)
+    {
+        xlang_delete_string(str);
+    }
+
+    after = get_statistics();
+    REQUIRE(after.utf8_strings.live_heap_strings == before.utf8_strings.live_heap_strings);
+}
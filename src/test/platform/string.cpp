@@ -359,6 +359,114 @@ TEST_CASE("Simple UTF-16 preallocated string buffer")
     simple_preallocated<char16_t>();
 }
 
+template <typename char_type>
+void recycled_preallocated()
+{
+    using other_type = typename alternate_type<char_type>::type;
+
+    for (uint32_t const pre_length : { 1u, 20u, 200u })
+    {
+        xlang_string_buffer buffer_handle{};
+        char_type* pre_buffer{};
+        REQUIRE(xlang_preallocate_string_buffer<char_type>(pre_length, &pre_buffer, &buffer_handle) == nullptr);
+        std::fill(pre_buffer, pre_buffer + pre_length, static_cast<char_type>('x'));
+
+        // Promoting a shorter string and converting it leaves nothing behind in the block for its next use.
+        xlang_string str{};
+        REQUIRE(xlang_promote_string_buffer(buffer_handle, &str, pre_length / 2 + 1) == nullptr);
+        other_type const* other_buffer{};
+        uint32_t length{};
+        REQUIRE(xlang_get_string_raw_buffer<other_type>(str, &other_buffer, &length) == nullptr);
+        REQUIRE(length == pre_length / 2 + 1);
+        xlang_delete_string(str);
+
+        xlang_pal_statistics before{};
+        xlang_get_pal_statistics(&before);
+
+        char_type* reused_buffer{};
+        REQUIRE(xlang_preallocate_string_buffer<char_type>(pre_length, &reused_buffer, &buffer_handle) == nullptr);
+        REQUIRE(reused_buffer == pre_buffer);
+        REQUIRE(reused_buffer[pre_length] == 0);
+
+        xlang_pal_statistics after{};
+        xlang_get_pal_statistics(&after);
+        REQUIRE(after.string_buffer_pool.allocations == before.string_buffer_pool.allocations + 1);
+        REQUIRE(after.string_buffer_pool.reuses == before.string_buffer_pool.reuses + 1);
+        REQUIRE(after.string_buffer_pool.cached_blocks == before.string_buffer_pool.cached_blocks - 1);
+
+        std::fill(reused_buffer, reused_buffer + pre_length, static_cast<char_type>('y'));
+        REQUIRE(xlang_promote_string_buffer(buffer_handle, &str, pre_length) == nullptr);
+        REQUIRE(xlang_get_string_raw_buffer<other_type>(str, &other_buffer, &length) == nullptr);
+        REQUIRE(length == pre_length);
+        REQUIRE(other_buffer[0] == 'y');
+        xlang_delete_string(str);
+
+        xlang_get_pal_statistics(&after);
+        REQUIRE(after.string_buffer_pool.recycles == before.string_buffer_pool.recycles + 1);
+    }
+}
+
+TEST_CASE("Recycled UTF-8 preallocated string buffer")
+{
+    recycled_preallocated<xlang_char8>();
+}
+
+TEST_CASE("Recycled UTF-16 preallocated string buffer")
+{
+    recycled_preallocated<char16_t>();
+}
+
+TEST_CASE("Recycled preallocated string buffers across threads")
+{
+    std::vector<xlang_string> strings(1000);
+
+    std::thread{ [&]
+    {
+        for (auto&& str : strings)
+        {
+            xlang_string_buffer buffer_handle{};
+            xlang_char8* buffer{};
+            REQUIRE(xlang_preallocate_string_buffer_utf8(16, &buffer, &buffer_handle) == nullptr);
+            std::fill(buffer, buffer + 16, 'z');
+            REQUIRE(xlang_promote_string_buffer(buffer_handle, &str, 16) == nullptr);
+        }
+    } }.join();
+
+    // The strings are freed on a different thread than the one that created them, and their blocks remain
+    // usable by both.
+    for (auto&& str : strings)
+    {
+        xlang_delete_string(str);
+    }
+
+    std::thread{ [&]
+    {
+        for (size_t i = 0; i < strings.size(); ++i)
+        {
+            xlang_string_buffer buffer_handle{};
+            xlang_char8* buffer{};
+            REQUIRE(xlang_preallocate_string_buffer_utf8(16, &buffer, &buffer_handle) == nullptr);
+            std::fill(buffer, buffer + 16, 'w');
+            REQUIRE(xlang_delete_string_buffer(buffer_handle) == nullptr);
+        }
+    } }.join();
+}
+
+TEST_CASE("Preallocated string buffer benchmark", "[.][benchmark]")
+{
+    BENCHMARK("Preallocate, promote and delete")
+    {
+        xlang_string_buffer buffer_handle{};
+        xlang_char8* buffer{};
+        xlang_preallocate_string_buffer_utf8(24, &buffer, &buffer_handle);
+        std::fill(buffer, buffer + 24, 'a');
+        xlang_string str{};
+        xlang_promote_string_buffer(buffer_handle, &str, 24);
+        xlang_delete_string(str);
+        return str;
+    };
+}
+
 template <typename char_type>
 void convert_string()
 {
@@ -508,3 +616,350 @@ TEST_CASE("Convert UTF-16 string reference")
 {
     convert_string_reference<char16_t>();
 }
+
+template <typename char_type>
+basic_string_view<typename alternate_type<char_type>::type> convert(xlang_string str)
+{
+    using other_type = typename alternate_type<char_type>::type;
+    other_type const* buffer{};
+    uint32_t length{};
+    REQUIRE(xlang_get_string_raw_buffer<other_type>(str, &buffer, &length) == nullptr);
+    return { buffer, length };
+}
+
+template <typename char_type>
+void convert_ascii_runs(basic_string_view<xlang_char8> const& utf8, basic_string_view<char16_t> const& utf16)
+{
+    // ASCII is converted a block at a time, so non-ASCII characters are placed before, within, and after blocks,
+    // in strings both short enough to be converted on the stack and too long to be.
+    using other_type = typename alternate_type<char_type>::type;
+    auto const source = std::get<basic_string_view<char_type>>(std::make_tuple(utf8, utf16));
+    auto const expected = std::get<basic_string_view<other_type>>(std::make_tuple(utf8, utf16));
+
+    for (size_t prefix = 0; prefix != 40; ++prefix)
+    {
+        for (size_t suffix : { 0, 1, 15, 16, 17, 33, 300, 400 })
+        {
+            basic_string<char_type> input(prefix, 'a');
+            input += source;
+            input.append(suffix, 'z');
+
+            basic_string<other_type> output(prefix, 'a');
+            output += expected;
+            output.append(suffix, 'z');
+
+            xlang_string str{};
+            REQUIRE(xlang_create_string(input.data(), static_cast<uint32_t>(input.size()), &str) == nullptr);
+            REQUIRE(convert<char_type>(str) == output);
+            xlang_delete_string(str);
+        }
+    }
+}
+
+TEST_CASE("Convert strings with ASCII runs")
+{
+    convert_ascii_runs<xlang_char8>(u8"\u007f"sv, u"\u007f"sv);
+    convert_ascii_runs<xlang_char8>(u8"\u0080"sv, u"\u0080"sv);
+    convert_ascii_runs<xlang_char8>(u8"中文"sv, u"中文"sv);
+    convert_ascii_runs<xlang_char8>(u8"\U0010ffff"sv, u"\U0010ffff"sv);
+    convert_ascii_runs<char16_t>(u8"\u007f"sv, u"\u007f"sv);
+    convert_ascii_runs<char16_t>(u8"\u0080"sv, u"\u0080"sv);
+    convert_ascii_runs<char16_t>(u8"中文"sv, u"中文"sv);
+    convert_ascii_runs<char16_t>(u8"\U0010ffff"sv, u"\U0010ffff"sv);
+}
+
+TEST_CASE("Fail to convert invalid strings after ASCII runs")
+{
+    for (size_t prefix : { 15, 16, 17, 32, 40 })
+    {
+        basic_string<xlang_char8> utf8(prefix, 'a');
+        utf8 += static_cast<xlang_char8>(0xff);
+        basic_string<char16_t> utf16(prefix, 'a');
+        utf16 += static_cast<char16_t>(0xd800);
+
+        xlang_string str{};
+        char16_t const* utf16_buffer{};
+        xlang_char8 const* utf8_buffer{};
+        uint32_t length{};
+
+        REQUIRE(xlang_create_string(utf8.data(), static_cast<uint32_t>(utf8.size()), &str) == nullptr);
+        REQUIRE(xlang_get_string_raw_buffer(str, &utf16_buffer, &length) != nullptr);
+        xlang_delete_string(str);
+
+        REQUIRE(xlang_create_string(utf16.data(), static_cast<uint32_t>(utf16.size()), &str) == nullptr);
+        REQUIRE(xlang_get_string_raw_buffer(str, &utf8_buffer, &length) != nullptr);
+        xlang_delete_string(str);
+    }
+}
+
+template <typename char_type>
+size_t convert_each(vector<basic_string<char_type>> const& strings)
+{
+    size_t result{};
+
+    for (auto&& value : strings)
+    {
+        xlang_string str{};
+        xlang_create_string(value.data(), static_cast<uint32_t>(value.size()), &str);
+        result += convert<char_type>(str).size();
+        xlang_delete_string(str);
+    }
+
+    return result;
+}
+
+TEST_CASE("String conversion benchmark", "[.][benchmark]")
+{
+    vector<basic_string<xlang_char8>> short_utf8;
+    vector<basic_string<char16_t>> short_utf16;
+
+    for (int i = 0; i < 1024; ++i)
+    {
+        auto name = "Windows.Foundation.Collections.IVector" + to_string(i);
+        short_utf8.emplace_back(name.begin(), name.end());
+        short_utf16.emplace_back(name.begin(), name.end());
+    }
+
+    vector<basic_string<xlang_char8>> long_utf8(16);
+    vector<basic_string<char16_t>> long_utf16(16);
+
+    for (size_t i = 0; i < long_utf8.size(); ++i)
+    {
+        for (int line = 0; line < 64; ++line)
+        {
+            long_utf8[i] += u8"The quick brown fox jumps over the lazy dog. ";
+            long_utf16[i] += u"The quick brown fox jumps over the lazy dog. ";
+
+            if (line % 8 == 0)
+            {
+                long_utf8[i] += u8"é中 ";
+                long_utf16[i] += u"é中 ";
+            }
+        }
+    }
+
+    BENCHMARK("short UTF-8 to UTF-16")
+    {
+        return convert_each(short_utf8);
+    };
+
+    BENCHMARK("short UTF-16 to UTF-8")
+    {
+        return convert_each(short_utf16);
+    };
+
+    BENCHMARK("multi-KB UTF-8 to UTF-16")
+    {
+        return convert_each(long_utf8);
+    };
+
+    BENCHMARK("multi-KB UTF-16 to UTF-8")
+    {
+        return convert_each(long_utf16);
+    };
+}
+
+template <typename char_type>
+void interned_string()
+{
+    using other_type = typename alternate_type<char_type>::type;
+
+    for (basic_string_view<char_type> const test_string : valid_strings<char_type>::value)
+    {
+        // Interning copies the value, so the handle must not depend on the caller's buffer.
+        basic_string<char_type> copy{ test_string };
+        xlang_string first{};
+        xlang_string second{};
+        REQUIRE(xlang_create_interned_string(test_string.data(), static_cast<uint32_t>(test_string.size()), &first) == nullptr);
+        REQUIRE(xlang_create_interned_string(copy.data(), static_cast<uint32_t>(copy.size()), &second) == nullptr);
+        REQUIRE(first == second);
+
+        if (test_string.empty())
+        {
+            REQUIRE(first == nullptr);
+            continue;
+        }
+
+        char_type const* buffer{};
+        uint32_t length{};
+        REQUIRE(xlang_get_string_raw_buffer<char_type>(first, &buffer, &length) == nullptr);
+        REQUIRE(basic_string_view<char_type>{ buffer, length } == test_string);
+        REQUIRE(buffer != copy.data());
+
+        // Duplicating returns the same handle, and deleting leaves the string intact.
+        xlang_string duplicate{};
+        REQUIRE(xlang_duplicate_string(first, &duplicate) == nullptr);
+        REQUIRE(duplicate == first);
+        xlang_delete_string(duplicate);
+        xlang_delete_string(second);
+        xlang_delete_string(first);
+
+        REQUIRE(xlang_get_string_raw_buffer<char_type>(first, &buffer, &length) == nullptr);
+        REQUIRE(basic_string_view<char_type>{ buffer, length } == test_string);
+
+        other_type const* other_buffer{};
+        REQUIRE(xlang_get_string_raw_buffer<other_type>(first, &other_buffer, &length) == nullptr);
+        REQUIRE(has_encoding<other_type>(first));
+    }
+
+    xlang_string ordinary{};
+    xlang_string interned{};
+    basic_string<char_type> value(8, 'x');
+    REQUIRE(xlang_create_string(value.data(), static_cast<uint32_t>(value.size()), &ordinary) == nullptr);
+    REQUIRE(xlang_create_interned_string(value.data(), static_cast<uint32_t>(value.size()), &interned) == nullptr);
+    REQUIRE(ordinary != interned);
+    xlang_delete_string(ordinary);
+}
+
+TEST_CASE("Interned UTF-8 strings")
+{
+    interned_string<xlang_char8>();
+}
+
+TEST_CASE("Interned UTF-16 strings")
+{
+    interned_string<char16_t>();
+}
+
+template <typename char_type>
+void small_string()
+{
+    using other_type = typename alternate_type<char_type>::type;
+
+    for (char_type const value : { char_type{ 'a' }, char_type{ ' ' }, char_type{ 0 }, char_type{ 0x7F } })
+    {
+        xlang_string first{};
+        xlang_string second{};
+        REQUIRE(xlang_create_string(&value, 1, &first) == nullptr);
+        REQUIRE(xlang_create_string(&value, 1, &second) == nullptr);
+        REQUIRE(first == second);
+
+        xlang_string interned{};
+        REQUIRE(xlang_create_interned_string(&value, 1, &interned) == nullptr);
+        REQUIRE(interned == first);
+
+        char_type const terminated[]{ value, 0 };
+        xlang_string_header header{};
+        xlang_string reference{};
+        xlang_string duplicate{};
+        REQUIRE(xlang_create_string_reference(terminated, 1, &header, &reference) == nullptr);
+        REQUIRE(xlang_duplicate_string(reference, &duplicate) == nullptr);
+        REQUIRE(duplicate == first);
+
+        xlang_string_buffer buffer_handle{};
+        char_type* buffer{};
+        xlang_string promoted{};
+        REQUIRE(xlang_preallocate_string_buffer<char_type>(4, &buffer, &buffer_handle) == nullptr);
+        buffer[0] = value;
+        REQUIRE(xlang_promote_string_buffer(buffer_handle, &promoted, 1) == nullptr);
+        REQUIRE(promoted == first);
+
+        xlang_delete_string(first);
+        xlang_delete_string(second);
+        xlang_delete_string(duplicate);
+        xlang_delete_string(promoted);
+
+        char_type const* raw{};
+        uint32_t length{};
+        REQUIRE(xlang_get_string_raw_buffer<char_type>(first, &raw, &length) == nullptr);
+        REQUIRE(length == 1);
+        REQUIRE(raw[0] == value);
+        REQUIRE(raw[1] == 0);
+
+        other_type const* other_raw{};
+        REQUIRE(xlang_get_string_raw_buffer<other_type>(first, &other_raw, &length) == nullptr);
+        REQUIRE(length == 1);
+        REQUIRE(static_cast<uint32_t>(other_raw[0]) == static_cast<uint32_t>(value));
+    }
+
+    // Longer strings and single non-ASCII characters are still separate strings.
+    char_type const pair[]{ 'a', 'b' };
+    xlang_string first{};
+    xlang_string second{};
+    REQUIRE(xlang_create_string(pair, 2, &first) == nullptr);
+    REQUIRE(xlang_create_string(pair, 2, &second) == nullptr);
+    REQUIRE(first != second);
+    xlang_delete_string(first);
+    xlang_delete_string(second);
+
+    if constexpr (std::is_same_v<char_type, char16_t>)
+    {
+        char16_t const value = 0xE9;
+        REQUIRE(xlang_create_string(&value, 1, &first) == nullptr);
+        REQUIRE(xlang_create_string(&value, 1, &second) == nullptr);
+        REQUIRE(first != second);
+        xlang_delete_string(first);
+        xlang_delete_string(second);
+    }
+}
+
+TEST_CASE("Small UTF-8 strings")
+{
+    small_string<xlang_char8>();
+}
+
+TEST_CASE("Small UTF-16 strings")
+{
+    small_string<char16_t>();
+}
+
+TEST_CASE("Small string benchmark", "[.][benchmark]")
+{
+    xlang_char8 const value[]{ 'a', 'b' };
+
+    BENCHMARK("Create and delete one character")
+    {
+        xlang_string str{};
+        xlang_create_string_utf8(value, 1, &str);
+        xlang_delete_string(str);
+        return str;
+    };
+
+    BENCHMARK("Create and delete two characters")
+    {
+        xlang_string str{};
+        xlang_create_string_utf8(value, 2, &str);
+        xlang_delete_string(str);
+        return str;
+    };
+}
+
+TEST_CASE("Interned strings across threads")
+{
+    std::vector<basic_string<xlang_char8>> names;
+
+    for (int i = 0; i < 256; ++i)
+    {
+        auto const name = "Windows.Foundation.Uri" + to_string(i);
+        names.emplace_back(name.begin(), name.end());
+    }
+
+    std::vector<std::vector<xlang_string>> results(4);
+    std::vector<std::thread> threads;
+
+    for (auto&& result : results)
+    {
+        threads.emplace_back([&]
+        {
+            for (auto&& name : names)
+            {
+                xlang_string str{};
+                xlang_create_interned_string(name.data(), static_cast<uint32_t>(name.size()), &str);
+                result.push_back(str);
+            }
+        });
+    }
+
+    for (auto&& thread : threads)
+    {
+        thread.join();
+    }
+
+    for (auto&& result : results)
+    {
+        REQUIRE(result == results.front());
+    }
+
+    std::sort(results.front().begin(), results.front().end());
+    REQUIRE(std::unique(results.front().begin(), results.front().end()) == results.front().end());
+}
@@ -16,6 +16,20 @@ auto xlang_create_string(char_type const* source, uint32_t length, xlang_string*
     }
 }
 
+template <typename char_type>
+auto xlang_create_interned_string(char_type const* source, uint32_t length, xlang_string* str)
+{
+    static_assert(std::disjunction_v<std::is_same<char_type, xlang_char8>, std::is_same<char_type, char16_t>>);
+    if constexpr (std::is_same_v<char_type, xlang_char8>)
+    {
+        return xlang_create_interned_string_utf8(source, length, str);
+    }
+    else
+    {
+        return xlang_create_interned_string_utf16(source, length, str);
+    }
+}
+
 template <typename char_type>
 auto xlang_create_string_reference(char_type const* source, uint32_t length, xlang_string_header* header, xlang_string* str)
 {
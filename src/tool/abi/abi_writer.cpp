@@ -422,6 +422,7 @@ static void write_c_type_definitions(writer& w, type_cache const& types)
 
 void write_abi_header(std::string_view fileName, abi_configuration const& config, type_cache const& types)
 {
+    xlang::profile_scope profile{ "write_abi_header" };
     writer w{ config };
 
     // All headers begin with a bit of boilerplate
@@ -444,8 +445,8 @@ void write_abi_header(std::string_view fileName, abi_configuration const& config
     }
     w.write(strings::constexpr_definitions);
 
-    write_api_contract_definitions(w, types);
-    write_includes(w, types, fileName);
+    w.write_profiled<write_api_contract_definitions>(types);
+    w.write_profiled<write_includes>(types, fileName);
 
     // C++ interface
     w.write("#if defined(__cplusplus) && !defined(CINTERFACE)\n");
@@ -454,19 +455,19 @@ void write_abi_header(std::string_view fileName, abi_configuration const& config
         w.write(strings::enum_class);
     }
 
-    write_cpp_interface_forward_declarations(w, types);
-    write_cpp_generic_definitions(w, types);
-    write_cpp_dependency_forward_declarations(w, types);
-    write_cpp_type_definitions(w, types);
+    w.write_profiled<write_cpp_interface_forward_declarations>(types);
+    w.write_profiled<write_cpp_generic_definitions>(types);
+    w.write_profiled<write_cpp_dependency_forward_declarations>(types);
+    w.write_profiled<write_cpp_type_definitions>(types);
 
     // C interface
     w.write("#else // !defined(__cplusplus)\n");
     w.begin_c_interface();
 
-    write_c_interface_forward_declarations(w, types);
-    write_c_generic_definitions(w, types);
-    write_c_dependency_forward_declarations(w, types);
-    write_c_type_definitions(w, types);
+    w.write_profiled<write_c_interface_forward_declarations>(types);
+    w.write_profiled<write_c_generic_definitions>(types);
+    w.write_profiled<write_c_dependency_forward_declarations>(types);
+    w.write_profiled<write_c_type_definitions>(types);
 
     w.write("#endif // defined(__cplusplus)");
 
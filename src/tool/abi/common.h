@@ -28,6 +28,7 @@ struct abi_configuration
     bool enable_header_deprecation = false;
 
     std::string output_directory;
+    std::string profile;
 };
 
 namespace xlang
@@ -206,7 +207,7 @@ struct deprecation_info
 };
 
 template <typename T>
-inline std::optional<deprecation_info> is_deprecated(T const& type)
+inline std::optional<deprecation_info> decode_deprecation(T const& type)
 {
     using namespace std::literals;
     using namespace xlang::meta::reader;
@@ -248,7 +249,7 @@ inline bool is_flags_enum(xlang::meta::reader::TypeDef const& type)
 }
 
 template <typename T>
-bool is_experimental(T const& value)
+bool has_experimental_attribute(T const& value)
 {
     using namespace std::literals;
     return static_cast<bool>(get_attribute(value, metadata_namespace, "ExperimentalAttribute"sv));
@@ -1,4 +1,7 @@
 #include "pch.h"
+#if !defined(XLANG_DRIVER)
+#include "profiler_new.h"
+#endif
 
 #include "abi_writer.h"
 #include "common.h"
@@ -35,6 +38,7 @@ static constexpr option options[]
     { "enum-class", 0, 0, {}, "Use 'MIDL_ENUM', rather than 'enum'" },
     { "lowercase-include-guard", 0, 0, {}, "Generate lowercase include guards for compatibility with Windows SDK headers" },
     { "enable-header-deprecation", 0, 0, {}, "Generate support for [[deprecated(...)]] attribute" },
+    { "profile", 0, 1, "<path>", "Write a Chrome trace-event timing profile of generation" },
     { "help", 0, option::no_max, {}, "Show detailed help with examples" },
 };
 
@@ -74,7 +78,7 @@ Where <spec> is one or more of:
     w.write(format, ABIWINRT_VERSION_STRING, bind_each(printOption, options));
 }
 
-int main(int const argc, char** argv)
+int abi_main(int const argc, char** argv)
 {
     int exitCode = 0;
     basic_writer w;
@@ -96,6 +100,7 @@ int main(int const argc, char** argv)
         config.enum_class = args.exists("enum-class");
         config.lowercase_include_guard = args.exists("lowercase-include-guard");
         config.enable_header_deprecation = args.exists("enable-header-deprecation");
+        config.profile = args.value("profile");
 
         if (args.exists("ns-prefix"))
         {
@@ -154,7 +159,18 @@ int main(int const argc, char** argv)
         filesToRead.insert(filesToRead.end(), inputFiles.begin(), inputFiles.end());
         filesToRead.insert(filesToRead.end(), referenceFiles.begin(), referenceFiles.end());
 
-        cache c{ filesToRead };
+        std::optional<profiler> profile;
+
+        if (!config.profile.empty() && !cache_pool::current())
+        {
+            profile.emplace(config.profile);
+        }
+
+        std::optional<profile_scope> profile_load{ std::in_place, "load_metadata" };
+        std::optional<cache> storage;
+        auto const& c = cache_pool::load(filesToRead, storage);
+        profile_load.reset();
+        attribute_cache attributes{ c };
         metadata_cache mdCache{ c };
 
         auto include = args.values("include");
@@ -181,6 +197,13 @@ int main(int const argc, char** argv)
         }
 
         filter f{ include, args.values("exclude") };
+        std::optional<output_sink> sink;
+
+        if (!output_sink::current())
+        {
+            sink.emplace();
+        }
+
         task_group group;
         auto filter_includes = [&](namespace_cache const& types)
         {
@@ -221,6 +244,7 @@ int main(int const argc, char** argv)
                 {
                     group.add([&, ns = ns]()
                     {
+                        profile_scope profile{ ns, ns };
                         write_abi_header(ns, config, mdCache.compile_namespaces({ ns }));
                     });
                 }
@@ -251,6 +275,7 @@ int main(int const argc, char** argv)
                 }
                 else
                 {
+                    profile_scope profile{ foundation_namespace, foundation_namespace };
                     auto types = mdCache.compile_namespaces({ foundation_namespace, collections_namespace });
                     write_abi_header(foundation_namespace, config, types);
                 }
@@ -258,6 +283,12 @@ int main(int const argc, char** argv)
         }
 
         group.get();
+        output_sink::current()->get();
+
+        if (profile)
+        {
+            profile->save();
+        }
 
         if (config.verbose)
         {
@@ -278,3 +309,10 @@ int main(int const argc, char** argv)
     w.flush_to_console();
     return exitCode;
 }
+
+#if !defined(XLANG_DRIVER)
+int main(int const argc, char** argv)
+{
+    return abi_main(argc, argv);
+}
+#endif
@@ -11,6 +11,8 @@ using namespace xlang::text;
 
 metadata_cache::metadata_cache(xlang::meta::reader::cache const& c)
 {
+    xlang::profile_scope profile{ "metadata_cache" };
+
     // We need to initialize in two phases. The first phase creates the collection of all type defs. The second phase
     // processes dependencies and initializes generic types
     // NOTE: We may only need to do this for a subset of types, but that would introduce a fair amount of complexity and
@@ -45,6 +47,13 @@ metadata_cache::metadata_cache(xlang::meta::reader::cache const& c)
         });
     }
     group.get();
+
+    // Now that all types have been processed, the generic instantiations' IIDs can be computed since their signatures
+    // depend on struct members and default interfaces
+    for (auto& [key, entry] : m_genericInstantiations)
+    {
+        entry.inst.compute_iid();
+    }
 }
 
 void metadata_cache::process_namespace_types(
@@ -319,8 +328,7 @@ void metadata_cache::process_class_dependencies(init_state& state, class_type& t
                 // No match on the interface reference is okay so long as there is _no_ versioning information on the
                 // reference. If there's not, then the requirement applies to all versioning schemes, so we look at the
                 // interface for the versioning information
-                if (get_attribute(ifaceImpl, metadata_namespace, "ContractVersionAttribute"sv) ||
-                    get_attribute(ifaceImpl, metadata_namespace, "VersionAttribute"sv))
+                if (get_contract_history(ifaceImpl) || !get_platform_versions(ifaceImpl).empty())
                 {
                     continue;
                 }
@@ -564,17 +572,35 @@ metadata_type const& metadata_cache::find_dependent_type(init_state& state, Gene
         genericParams.push_back(&find_dependent_type(state, param));
     }
 
-    generic_inst inst{ genericType, std::move(genericParams) };
-    auto [itr, added] = state.target->generic_instantiations.emplace(inst.clr_full_name(), std::move(inst));
+    generic_entry* entry;
+    bool added;
+    {
+        std::lock_guard<std::mutex> guard{ m_genericLock };
+        generic_key key{ genericType, genericParams };
+        auto itr = m_genericInstantiations.find(key);
+        added = itr == m_genericInstantiations.end();
+        if (added)
+        {
+            itr = m_genericInstantiations.emplace(std::piecewise_construct,
+                std::forward_as_tuple(std::move(key)),
+                std::forward_as_tuple(genericType, std::move(genericParams))).first;
+        }
+
+        entry = &itr->second;
+    }
+
+    // Only the instantiation's name is needed here, which is available even if another thread is still processing it
+    state.target->generic_instantiations.emplace(entry->inst.clr_full_name(), entry->inst);
     if (added)
     {
-        auto restore = std::exchange(state.parent_generic_inst, &itr->second);
-        auto check_dependency = [&, &itr = itr](auto const& t)
+        auto& inst = entry->inst;
+        auto restore = std::exchange(state, init_state{ &entry->dependencies, &inst });
+        auto check_dependency = [&](auto const& t)
         {
             auto mdType = &find_dependent_type(state, t);
             if (auto genericType = dynamic_cast<generic_inst const*>(mdType))
             {
-                itr->second.dependencies.push_back(genericType);
+                inst.dependencies.push_back(genericType);
             }
         };
 
@@ -591,7 +617,7 @@ metadata_type const& metadata_cache::find_dependent_type(init_state& state, Gene
             }
 
             // TODO: Duplicated effort!
-            itr->second.functions.push_back(process_function(state, fn));
+            inst.functions.push_back(process_function(state, fn));
 
             auto sig = fn.Signature();
             if (sig.ReturnType())
@@ -605,10 +631,67 @@ metadata_type const& metadata_cache::find_dependent_type(init_state& state, Gene
             }
         }
 
-        state.parent_generic_inst = restore;
+        state = restore;
     }
 
-    return itr->second;
+    return entry->inst;
+}
+
+dependency_closure const& metadata_cache::get_closure(namespace_cache& target) const
+{
+    std::call_once(target.closure_flag, [&]()
+    {
+        auto& result = target.closure;
+        result.dependent_namespaces.assign(target.dependent_namespaces.begin(), target.dependent_namespaces.end());
+        result.generic_instantiations.assign(target.generic_instantiations.begin(), target.generic_instantiations.end());
+        result.type_dependencies.assign(target.type_dependencies.begin(), target.type_dependencies.end());
+
+        // Instantiations are unique, so they can be tracked by address while walking their dependencies
+        std::unordered_set<generic_inst const*> visited;
+        std::vector<generic_inst const*> pending;
+        for (auto const& [name, inst] : target.generic_instantiations)
+        {
+            visited.insert(&inst.get());
+            pending.push_back(&inst.get());
+        }
+
+        while (!pending.empty())
+        {
+            auto inst = pending.back();
+            pending.pop_back();
+
+            auto const& dependencies = m_genericInstantiations.at(generic_key{ inst->generic_type(), inst->generic_params() }).dependencies;
+            result.dependent_namespaces.insert(result.dependent_namespaces.end(),
+                dependencies.dependent_namespaces.begin(), dependencies.dependent_namespaces.end());
+            result.type_dependencies.insert(result.type_dependencies.end(),
+                dependencies.type_dependencies.begin(), dependencies.type_dependencies.end());
+
+            for (auto const& [name, dependency] : dependencies.generic_instantiations)
+            {
+                if (visited.insert(&dependency.get()).second)
+                {
+                    result.generic_instantiations.emplace_back(name, dependency);
+                    pending.push_back(&dependency.get());
+                }
+            }
+        }
+
+        auto sort_unique = [](auto& list, auto less, auto equal)
+        {
+            std::sort(list.begin(), list.end(), less);
+            list.erase(std::unique(list.begin(), list.end(), equal), list.end());
+        };
+
+        sort_unique(result.dependent_namespaces, std::less<>{}, std::equal_to<>{});
+        sort_unique(result.generic_instantiations,
+            [](auto const& lhs, auto const& rhs) { return lhs.first < rhs.first; },
+            [](auto const& lhs, auto const& rhs) { return lhs.first == rhs.first; });
+        sort_unique(result.type_dependencies,
+            [](auto const& lhs, auto const& rhs) { return lhs.get() < rhs.get(); },
+            [](auto const& lhs, auto const& rhs) { return &lhs.get() == &rhs.get(); });
+    });
+
+    return target.closure;
 }
 
 template <typename T>
@@ -620,9 +703,26 @@ static void merge_into(std::vector<T>& from, std::vector<std::reference_wrapper<
     to.swap(result);
 }
 
+template <typename T, typename Compare>
+static void merge_unique(std::vector<T> const& from, std::vector<T>& to, Compare compare)
+{
+    if (to.empty())
+    {
+        to = from;
+        return;
+    }
+
+    std::vector<T> result;
+    result.reserve(from.size() + to.size());
+    std::set_union(to.begin(), to.end(), from.begin(), from.end(), std::back_inserter(result), compare);
+    to.swap(result);
+}
+
 type_cache metadata_cache::compile_namespaces(std::initializer_list<std::string_view> targetNamespaces)
 {
+    xlang::profile_scope profile{ "compile_namespaces" };
     type_cache result{ this };
+    std::vector<std::reference_wrapper<typedef_base const>> typeDependencies;
 
     auto includes_namespace = [&](std::string_view ns)
     {
@@ -645,19 +745,14 @@ type_cache metadata_cache::compile_namespaces(std::initializer_list<std::string_
         merge_into(itr->second.interfaces, result.interfaces);
         merge_into(itr->second.classes, result.classes);
 
-        // Merge the dependencies together
-        result.dependent_namespaces.insert(
-            itr->second.dependent_namespaces.begin(),
-            itr->second.dependent_namespaces.end());
-
-        result.generic_instantiations.insert(itr->second.generic_instantiations.begin(), itr->second.generic_instantiations.end());
-
-        std::partition_copy(
-            itr->second.type_dependencies.begin(),
-            itr->second.type_dependencies.end(),
-            std::inserter(result.internal_dependencies, result.internal_dependencies.end()),
-            std::inserter(result.external_dependencies, result.external_dependencies.end()),
-            [&](auto const& type) { return includes_namespace(type.get().clr_logical_namespace()); });
+        // Merge the dependencies together. Each namespace's closure is already sorted, so in the common case of a
+        // single namespace these are simple copies
+        auto const& closure = get_closure(itr->second);
+        merge_unique(closure.dependent_namespaces, result.dependent_namespaces, std::less<>{});
+        merge_unique(closure.generic_instantiations, result.generic_instantiations,
+            [](auto const& lhs, auto const& rhs) { return lhs.first < rhs.first; });
+        merge_unique(closure.type_dependencies, typeDependencies,
+            [](auto const& lhs, auto const& rhs) { return lhs.get() < rhs.get(); });
 
         // Remove any "built-in types" since these are either defined in other header files or are metadata only types
         auto remove_type = [&](auto& list, std::string_view name)
@@ -684,6 +779,18 @@ type_cache metadata_cache::compile_namespaces(std::initializer_list<std::string_
         }
     }
 
+    // Dependencies on types in the target namespaces keep their order, which is by full name, so the external
+    // dependencies need no further sorting
+    for (auto const& type : typeDependencies)
+    {
+        auto& target = includes_namespace(type.get().clr_logical_namespace()) ?
+            result.internal_dependencies :
+            result.external_dependencies;
+        target.push_back(type);
+    }
+
+    std::sort(result.internal_dependencies.begin(), result.internal_dependencies.end(), category_compare{});
+
     // Structs need all members to be defined prior to the struct definition
     std::pair range{ result.structs.begin(), result.structs.end() };
     while (range.first != range.second)
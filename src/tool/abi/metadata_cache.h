@@ -4,6 +4,7 @@
 #include <mutex>
 #include <string>
 #include <unordered_map>
+#include <unordered_set>
 #include <vector>
 
 #include "meta_reader.h"
@@ -23,8 +24,8 @@ struct category_compare
     bool operator()(typedef_base const& lhs, typedef_base const& rhs) const
     {
         using namespace xlang::meta::reader;
-        auto leftCat = get_category(lhs.type());
-        auto rightCat = get_category(rhs.type());
+        auto leftCat = lhs.category();
+        auto rightCat = rhs.category();
         if (leftCat == rightCat)
         {
             return lhs.clr_full_name() < rhs.clr_full_name();
@@ -46,6 +47,8 @@ struct category_compare
     }
 };
 
+using generic_inst_entry = std::pair<std::string_view, std::reference_wrapper<generic_inst const>>;
+
 struct metadata_cache;
 
 struct type_cache
@@ -59,11 +62,21 @@ struct type_cache
     std::vector<std::reference_wrapper<interface_type const>> interfaces;
     std::vector<std::reference_wrapper<class_type const>> classes;
 
-    // Dependencies
-    std::set<std::string_view> dependent_namespaces;
-    std::map<std::string_view, std::reference_wrapper<generic_inst const>> generic_instantiations;
-    std::set<std::reference_wrapper<typedef_base const>> external_dependencies;
-    std::set<std::reference_wrapper<typedef_base const>, category_compare> internal_dependencies;
+    // Dependencies. Namespaces and generic instantiations are sorted by name, external dependencies by full name, and
+    // internal dependencies by category_compare
+    std::vector<std::string_view> dependent_namespaces;
+    std::vector<generic_inst_entry> generic_instantiations;
+    std::vector<std::reference_wrapper<typedef_base const>> external_dependencies;
+    std::vector<std::reference_wrapper<typedef_base const>> internal_dependencies;
+};
+
+// A namespace's dependencies, including those of the generic instantiations that it references directly or
+// indirectly, flattened into sorted arrays
+struct dependency_closure
+{
+    std::vector<std::string_view> dependent_namespaces;
+    std::vector<generic_inst_entry> generic_instantiations;
+    std::vector<std::reference_wrapper<typedef_base const>> type_dependencies;
 };
 
 struct namespace_cache
@@ -78,8 +91,12 @@ struct namespace_cache
 
     // Dependencies
     std::set<std::string_view> dependent_namespaces;
-    std::map<std::string_view, generic_inst> generic_instantiations;
+    std::map<std::string_view, std::reference_wrapper<generic_inst const>> generic_instantiations;
     std::set<std::reference_wrapper<typedef_base const>> type_dependencies;
+
+    // Computed on first use by metadata_cache::compile_namespaces
+    std::once_flag closure_flag;
+    dependency_closure closure;
 };
 
 struct metadata_cache
@@ -134,6 +151,7 @@ private:
     };
 
     void process_namespace_dependencies(namespace_cache& target);
+    dependency_closure const& get_closure(namespace_cache& target) const;
     void process_enum_dependencies(init_state& state, enum_type& type);
     void process_struct_dependencies(init_state& state, struct_type& type);
     void process_delegate_dependencies(init_state& state, delegate_type& type);
@@ -151,4 +169,48 @@ private:
     metadata_type const& find_dependent_type(init_state& state, xlang::meta::reader::GenericTypeInstSig const& type);
 
     std::map<std::string_view, std::map<std::string_view, metadata_type const&>> m_typeTable;
+
+    // Generic instantiations are shared by all namespaces. Each one is processed once, by whichever thread first
+    // encounters it, and the dependencies it introduces are recorded alongside it so that they can be merged into
+    // the closure of each namespace that (transitively) references it when that namespace is first compiled. Instantiations are
+    // keyed by the generic type and arguments rather than by name, which is unambiguous since nested instantiations
+    // are themselves unique
+    struct generic_key
+    {
+        typedef_base const* generic_type;
+        std::vector<metadata_type const*> generic_params;
+
+        bool operator==(generic_key const& other) const noexcept
+        {
+            return (generic_type == other.generic_type) && (generic_params == other.generic_params);
+        }
+    };
+
+    struct generic_key_hash
+    {
+        std::size_t operator()(generic_key const& key) const noexcept
+        {
+            auto result = std::hash<void const*>{}(key.generic_type);
+            for (auto param : key.generic_params)
+            {
+                result ^= std::hash<void const*>{}(param) + 0x9e3779b9 + (result << 6) + (result >> 2);
+            }
+
+            return result;
+        }
+    };
+
+    struct generic_entry
+    {
+        generic_entry(typedef_base const* genericType, std::vector<metadata_type const*> genericParams) :
+            inst(genericType, std::move(genericParams))
+        {
+        }
+
+        generic_inst inst;
+        namespace_cache dependencies;
+    };
+
+    std::mutex m_genericLock;
+    std::unordered_map<generic_key, generic_entry, generic_key_hash> m_genericInstantiations;
 };
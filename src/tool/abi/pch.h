@@ -2,6 +2,7 @@
 
 #include <filesystem>
 
+#include "cache_pool.h"
 #include "cmd_reader.h"
 #include "meta_reader.h"
 #include "task_group.h"
@@ -4,6 +4,33 @@
 #include <array>
 #include <cstdint>
 #include <string_view>
+#include <utility>
+
+// The SHA extensions are only used at runtime, so they depend on being able to tell whether or not we're being
+// evaluated in a constant expression
+#if defined(__has_builtin)
+#if __has_builtin(__builtin_is_constant_evaluated)
+#define XLANG_SHA1_CONSTANT_EVALUATED
+#endif
+#elif defined(_MSC_VER) && (_MSC_VER >= 1925)
+#define XLANG_SHA1_CONSTANT_EVALUATED
+#endif
+
+#if defined(XLANG_SHA1_CONSTANT_EVALUATED) && (defined(_M_IX86) || defined(_M_X64) || defined(__i386__) || defined(__x86_64__))
+#define XLANG_SHA1_INTRINSICS
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#else
+#include <cpuid.h>
+#endif
+#endif
+
+#if defined(XLANG_SHA1_INTRINSICS) && (defined(__GNUC__) || defined(__clang__))
+#define XLANG_SHA1_TARGET __attribute__((target("sha,ssse3,sse4.1")))
+#else
+#define XLANG_SHA1_TARGET
+#endif
 
 template <typename T>
 inline constexpr std::uint8_t* bigendian_copy(T value, std::uint8_t* target) noexcept
@@ -29,28 +56,49 @@ struct sha1
     constexpr void reset() noexcept
     {
         m_sizeBytes = 0;
-        m_nextChunkByte = 0;
+        m_bufferSize = 0;
         m_state = { 0x67452301, 0xEFCDAB89, 0x98BADCFE, 0x10325476, 0xC3D2E1F0 };
     }
 
     constexpr void append(std::uint8_t const* data, std::uint64_t count) noexcept
     {
-        while (count > 0)
+        m_sizeBytes += count;
+
+        // Top off any partial chunk left over from a previous append before processing chunks in place
+        if (m_bufferSize != 0)
         {
-            auto bytesToCopy = (std::min)(count, chunk_size_bytes - m_nextChunkByte);
+            auto bytesToCopy = static_cast<std::size_t>((std::min)(count, chunk_size_bytes - m_bufferSize));
             for (std::size_t i = 0; i < bytesToCopy; ++i)
             {
-                append_byte(data[i]);
+                m_buffer[m_bufferSize + i] = data[i];
             }
 
-            if (m_nextChunkByte == chunk_size_bytes)
+            m_bufferSize += bytesToCopy;
+            data += bytesToCopy;
+            count -= bytesToCopy;
+
+            if (m_bufferSize != chunk_size_bytes)
             {
-                process_chunk();
+                return;
             }
 
-            count -= bytesToCopy;
-            data += bytesToCopy;
+            process_chunks(m_state, m_buffer.data(), 1);
+            m_bufferSize = 0;
+        }
+
+        if (auto chunks = static_cast<std::size_t>(count / chunk_size_bytes))
+        {
+            process_chunks(m_state, data, chunks);
+            data += chunks * chunk_size_bytes;
+            count -= chunks * chunk_size_bytes;
+        }
+
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            m_buffer[i] = data[i];
         }
+
+        m_bufferSize = static_cast<std::size_t>(count);
     }
 
     void append(std::string_view str) noexcept
@@ -61,29 +109,29 @@ struct sha1
     constexpr std::array<std::uint8_t, 20> finalize() noexcept
     {
         auto const sizeBits = m_sizeBytes * 8;
-        append_byte(0x80);
-
-        constexpr auto sizeOffset = chunk_size_bytes - 8;
-        while (m_nextChunkByte < sizeOffset)
-        {
-            append_byte(0);
-        }
+        m_buffer[m_bufferSize++] = 0x80;
 
         // We need to append the length to the very end, which means that we may need to process a mostly empty
         // additional chunk
-        if (m_nextChunkByte > sizeOffset)
+        constexpr auto sizeOffset = chunk_size_bytes - 8;
+        if (m_bufferSize > sizeOffset)
         {
-            while (m_nextChunkByte < chunk_size_bytes)
+            while (m_bufferSize < chunk_size_bytes)
             {
-                append_byte(0);
+                m_buffer[m_bufferSize++] = 0;
             }
-            process_chunk();
+
+            process_chunks(m_state, m_buffer.data(), 1);
+            m_bufferSize = 0;
         }
 
-        m_currentChunk[chunk_size_ints - 2] = static_cast<std::uint32_t>(sizeBits >> 32);
-        m_currentChunk[chunk_size_ints - 1] = static_cast<std::uint32_t>(sizeBits);
-        m_nextChunkByte = chunk_size_bytes;
-        process_chunk();
+        while (m_bufferSize < sizeOffset)
+        {
+            m_buffer[m_bufferSize++] = 0;
+        }
+
+        bigendian_copy(sizeBits, m_buffer.data() + sizeOffset);
+        process_chunks(m_state, m_buffer.data(), 1);
 
         std::array<std::uint8_t, 20> result = {};
         auto dest = result.data();
@@ -96,58 +144,205 @@ struct sha1
         return result;
     }
 
+    // True if chunks are processed using the SHA extensions when not evaluated at compile time
+    static bool hardware_accelerated() noexcept
+    {
+#if defined(XLANG_SHA1_INTRINSICS)
+        static bool const result = []
+        {
+#if defined(_MSC_VER)
+            int info[4];
+            __cpuid(info, 0);
+            if (info[0] < 7)
+            {
+                return false;
+            }
+
+            __cpuidex(info, 1, 0);
+            auto const ecx = static_cast<unsigned>(info[2]);
+            __cpuidex(info, 7, 0);
+            auto const ebx = static_cast<unsigned>(info[1]);
+#else
+            unsigned eax{}, ebx{}, ecx{}, edx{};
+            if (!__get_cpuid_count(7, 0, &eax, &ebx, &ecx, &edx))
+            {
+                return false;
+            }
+
+            auto const sha = ebx;
+            __get_cpuid(1, &eax, &ebx, &ecx, &edx);
+            ebx = sha;
+#endif
+            auto const ssse3 = (ecx & (1u << 9)) != 0;
+            auto const sse41 = (ecx & (1u << 19)) != 0;
+            auto const shani = (ebx & (1u << 29)) != 0;
+            return ssse3 && sse41 && shani;
+        }();
+
+        return result;
+#else
+        return false;
+#endif
+    }
+
 private:
 
-    constexpr void append_byte(std::uint8_t byte) noexcept
+    static constexpr bool is_constant_evaluated() noexcept
     {
-        auto index = static_cast<std::size_t>(m_nextChunkByte / 4);
-        auto pos = m_nextChunkByte % 4;
-        auto shift = (3 - pos) * 8;
-        m_currentChunk[index] |= (byte << shift);
-        ++m_nextChunkByte;
-        ++m_sizeBytes;
+#if defined(XLANG_SHA1_CONSTANT_EVALUATED)
+        return __builtin_is_constant_evaluated();
+#else
+        return true;
+#endif
     }
 
-    constexpr void process_chunk() noexcept
+    static constexpr void process_chunks(std::array<std::uint32_t, 5>& state, std::uint8_t const* data, std::size_t count) noexcept
     {
-        XLANG_ASSERT(m_nextChunkByte == chunk_size_bytes);
-        auto chunkState = m_state;
+#if defined(XLANG_SHA1_INTRINSICS)
+        if (!is_constant_evaluated() && hardware_accelerated())
+        {
+            process_chunks_intrinsics(state, data, count);
+            return;
+        }
+#endif
 
-        std::array<std::uint32_t, 80> w = {};
-        for (auto i = 0; i < 16; ++i) w[i] = m_currentChunk[i];
-        for (auto i = 16; i < 80; ++i)
+        for (; count != 0; --count, data += chunk_size_bytes)
         {
-            w[i] = lrot(w[i - 3] ^ w[i - 8] ^ w[i - 14] ^ w[i - 16], 1);
+            process_chunk(state, data);
         }
+    }
 
-        for (auto i = 0; i < 20; ++i)
+    static constexpr std::uint32_t load_bigendian(std::uint8_t const* data) noexcept
+    {
+        return (static_cast<std::uint32_t>(data[0]) << 24) |
+            (static_cast<std::uint32_t>(data[1]) << 16) |
+            (static_cast<std::uint32_t>(data[2]) << 8) |
+            static_cast<std::uint32_t>(data[3]);
+    }
+
+    static constexpr void process_chunk(std::array<std::uint32_t, 5>& state, std::uint8_t const* data) noexcept
+    {
+        auto chunkState = state;
+
+        // The message schedule only ever looks back 16 words, so it's kept in a circular buffer rather than
+        // expanded to all 80 words up front
+        std::array<std::uint32_t, 16> w = {};
+        for (std::size_t i = 0; i < chunk_size_ints; ++i)
+        {
+            w[i] = load_bigendian(data + i * 4);
+        }
+
+        auto schedule = [&](std::size_t i)
+        {
+            if (i < 16)
+            {
+                return w[i];
+            }
+
+            auto& value = w[i & 15];
+            value = lrot(w[(i - 3) & 15] ^ w[(i - 8) & 15] ^ w[(i - 14) & 15] ^ value, 1);
+            return value;
+        };
+
+        std::size_t i = 0;
+        for (; i < 20; ++i)
         {
             auto f = (chunkState[1] & chunkState[2]) | (~chunkState[1] & chunkState[3]);
-            rotate(chunkState, w[i], f, 0x5A827999);
+            rotate(chunkState, schedule(i), f, 0x5A827999);
         }
-        for (auto i = 20; i < 40; ++i)
+        for (; i < 40; ++i)
         {
             auto f = chunkState[1] ^ chunkState[2] ^ chunkState[3];
-            rotate(chunkState, w[i], f, 0x6ED9EBA1);
+            rotate(chunkState, schedule(i), f, 0x6ED9EBA1);
         }
-        for (auto i = 40; i < 60; ++i)
+        for (; i < 60; ++i)
         {
             auto f = (chunkState[1] & chunkState[2]) | (chunkState[1] & chunkState[3]) | (chunkState[2] & chunkState[3]);
-            rotate(chunkState, w[i], f, 0x8F1BBCDC);
+            rotate(chunkState, schedule(i), f, 0x8F1BBCDC);
         }
-        for (auto i = 60; i < 80; ++i)
+        for (; i < 80; ++i)
         {
             auto f = chunkState[1] ^ chunkState[2] ^ chunkState[3];
-            rotate(chunkState, w[i], f, 0xCA62C1D6);
+            rotate(chunkState, schedule(i), f, 0xCA62C1D6);
+        }
+
+        for (std::size_t j = 0; j < 5; ++j)
+        {
+            state[j] += chunkState[j];
         }
+    }
+
+#if defined(XLANG_SHA1_INTRINSICS)
+    // Each group performs four rounds. The message schedule for later groups is computed four words at a time
+    // alongside the rounds that consume the current words
+    template <int Group>
+    XLANG_SHA1_TARGET static void process_group(__m128i& abcd, __m128i (&e)[2], __m128i (&msg)[4]) noexcept
+    {
+        auto& current = msg[Group % 4];
 
-        for (auto i = 0; i < 5; ++i)
+        if constexpr (Group == 0)
+        {
+            e[0] = _mm_add_epi32(e[0], current);
+        }
+        else
         {
-            m_state[i] += chunkState[i];
+            e[Group % 2] = _mm_sha1nexte_epu32(e[Group % 2], current);
         }
-        m_nextChunkByte = 0;
-        m_currentChunk = {};
+
+        e[(Group + 1) % 2] = abcd;
+
+        if constexpr ((Group >= 3) && (Group <= 18))
+        {
+            msg[(Group + 1) % 4] = _mm_sha1msg2_epu32(msg[(Group + 1) % 4], current);
+        }
+
+        abcd = _mm_sha1rnds4_epu32(abcd, e[Group % 2], Group / 5);
+
+        if constexpr ((Group >= 1) && (Group <= 16))
+        {
+            msg[(Group + 3) % 4] = _mm_sha1msg1_epu32(msg[(Group + 3) % 4], current);
+        }
+
+        if constexpr ((Group >= 2) && (Group <= 17))
+        {
+            msg[(Group + 2) % 4] = _mm_xor_si128(msg[(Group + 2) % 4], current);
+        }
+    }
+
+    template <int... Groups>
+    XLANG_SHA1_TARGET static void process_groups(__m128i& abcd, __m128i (&e)[2], __m128i (&msg)[4], std::integer_sequence<int, Groups...>) noexcept
+    {
+        (process_group<Groups>(abcd, e, msg), ...);
+    }
+
+    XLANG_SHA1_TARGET static void process_chunks_intrinsics(std::array<std::uint32_t, 5>& state, std::uint8_t const* data, std::size_t count) noexcept
+    {
+        auto const byteSwap = _mm_set_epi64x(0x0001020304050607ull, 0x08090a0b0c0d0e0full);
+        auto abcd = _mm_shuffle_epi32(_mm_loadu_si128(reinterpret_cast<__m128i const*>(state.data())), 0x1B);
+        auto e0 = _mm_set_epi32(static_cast<int>(state[4]), 0, 0, 0);
+
+        for (; count != 0; --count, data += chunk_size_bytes)
+        {
+            auto const abcdSave = abcd;
+            auto const e0Save = e0;
+
+            __m128i msg[4];
+            for (std::size_t i = 0; i < 4; ++i)
+            {
+                msg[i] = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<__m128i const*>(data + i * 16)), byteSwap);
+            }
+
+            __m128i e[2] = { e0, {} };
+            process_groups(abcd, e, msg, std::make_integer_sequence<int, 20>{});
+
+            e0 = _mm_sha1nexte_epu32(e[0], e0Save);
+            abcd = _mm_add_epi32(abcd, abcdSave);
+        }
+
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(state.data()), _mm_shuffle_epi32(abcd, 0x1B));
+        state[4] = static_cast<std::uint32_t>(_mm_extract_epi32(e0, 3));
     }
+#endif
 
     template <typename T>
     static constexpr T lrot(T value, std::size_t count) noexcept
@@ -170,8 +365,8 @@ private:
 
     std::uint64_t m_sizeBytes = 0;
 
-    std::array<std::uint32_t, 16> m_currentChunk = {};
-    std::uint64_t m_nextChunkByte = 0;
+    std::array<std::uint8_t, chunk_size_bytes> m_buffer = {};
+    std::size_t m_bufferSize = 0;
 
     std::array<std::uint32_t, 5> m_state = { 0x67452301, 0xEFCDAB89, 0x98BADCFE, 0x10325476, 0xC3D2E1F0 };
 };
@@ -47,15 +47,13 @@ static void end_type_definition(writer& w, T const& type, std::size_t contractGu
 
 typedef_base::typedef_base(TypeDef const& type) :
     m_type(type),
+    m_category(get_category(type)),
     m_clrFullName(::clr_full_name(type)),
     m_mangledName(::mangled_name<false>(type)),
     m_genericParamMangledName(::mangled_name<true>(type)),
+    m_platformVersions(get_platform_versions(type)),
     m_contractHistory(get_contract_history(type))
 {
-    for_each_attribute(type, metadata_namespace, "VersionAttribute"sv, [&](bool, CustomAttribute const& attr)
-    {
-        m_platformVersions.push_back(decode_platform_version(attr));
-    });
 }
 
 std::size_t typedef_base::push_contract_guards(writer& w) const
@@ -1154,6 +1152,33 @@ void class_type::write_c_definition(writer& w) const
     write_cpp_definition(w);
 }
 
+void generic_inst::compute_iid()
+{
+    sha1 signatureHash;
+    static constexpr std::uint8_t namespaceGuidBytes[] =
+    {
+        0x11, 0xf4, 0x7a, 0xd5,
+        0x7b, 0x73,
+        0x42, 0xc0,
+        0xab, 0xae, 0x87, 0x8b, 0x1e, 0x16, 0xad, 0xee
+    };
+    signatureHash.append(namespaceGuidBytes, std::size(namespaceGuidBytes));
+    append_signature(signatureHash);
+
+    auto iidHash = signatureHash.finalize();
+    iidHash[6] = (iidHash[6] & 0x0F) | 0x50;
+    iidHash[8] = (iidHash[8] & 0x3F) | 0x80;
+
+    char buffer[37];
+    std::snprintf(buffer, std::size(buffer), "%02x%02x%02x%02x-%02x%02x-%02x%02x-%02x%02x-%02x%02x%02x%02x%02x%02x",
+        iidHash[0], iidHash[1], iidHash[2], iidHash[3],
+        iidHash[4], iidHash[5],
+        iidHash[6], iidHash[7],
+        iidHash[8], iidHash[9],
+        iidHash[10], iidHash[11], iidHash[12], iidHash[13], iidHash[14], iidHash[15]);
+    m_iid = buffer;
+}
+
 std::size_t generic_inst::push_contract_guards(writer& w) const
 {
     // Follow MIDLRT's lead and only write contract guards for the generic parameters
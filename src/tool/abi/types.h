@@ -510,13 +510,16 @@ struct typedef_base : metadata_type
 
     xlang::meta::reader::category category() const noexcept
     {
-        return get_category(m_type);
+        return m_category;
     }
 
 protected:
 
     xlang::meta::reader::TypeDef m_type;
 
+    // Cached since sorting dependencies compares categories far more often than there are types
+    xlang::meta::reader::category m_category;
+
     // These strings are initialized by the base class
     std::string m_clrFullName;
     std::string m_mangledName;
@@ -925,6 +928,16 @@ struct generic_inst final : metadata_type
         return m_genericParams;
     }
 
+    // The IID depends on the signatures of the generic arguments, which are only complete once all types have been
+    // processed, so it is computed once by the metadata_cache at that point rather than each time it is written
+    void compute_iid();
+
+    std::string_view iid() const noexcept
+    {
+        XLANG_ASSERT(!m_iid.empty());
+        return m_iid;
+    }
+
     std::vector<generic_inst const*> dependencies;
     std::vector<function_def> functions;
 
@@ -934,4 +947,5 @@ private:
     std::vector<metadata_type const*> m_genericParams;
     std::string m_clrFullName;
     std::string m_mangledName;
+    std::string m_iid;
 };
@@ -139,7 +139,7 @@ struct contract_history
 };
 
 template <typename T>
-inline std::optional<contract_history> get_contract_history(T const& value)
+inline std::optional<contract_history> decode_contract_history(T const& value)
 {
     using namespace std::literals;
     using namespace xlang::meta::reader;
@@ -220,6 +220,256 @@ inline std::optional<contract_history> get_contract_history(T const& value)
     return result;
 }
 
+template <typename T>
+inline std::vector<platform_version> decode_platform_versions(T const& value)
+{
+    using namespace std::literals;
+
+    std::vector<platform_version> result;
+    for_each_attribute(value, metadata_namespace, "VersionAttribute"sv, [&](bool /*first*/, auto const& attr)
+    {
+        result.push_back(decode_platform_version(attr));
+    });
+
+    return result;
+}
+
+// The versioning attributes of a single type, member, or interface implementation
+struct version_attributes
+{
+    std::optional<contract_history> history;
+    std::vector<platform_version> platform_versions;
+    std::optional<deprecation_info> deprecation;
+    bool experimental = false;
+};
+
+// The writers query the versioning attributes of the same rows for each type, member, and guard that they emit, so
+// these are decoded once, in parallel, for every row in the metadata that has any. Rows are keyed by their parent
+// index in the CustomAttribute table, which is sorted by parent, so each database's records are already in order
+struct attribute_cache
+{
+    attribute_cache(attribute_cache const&) = delete;
+    attribute_cache& operator=(attribute_cache const&) = delete;
+
+    explicit attribute_cache(xlang::meta::reader::cache const& c)
+    {
+        using namespace xlang::meta::reader;
+        xlang::profile_scope profile{ "attribute_cache" };
+
+        // Attributes are decoded in chunks of the CustomAttribute table, each extended so that a row's attributes are
+        // never split between chunks
+        constexpr std::uint32_t chunk_size = 4096;
+        std::vector<std::pair<CustomAttribute, CustomAttribute>> chunks;
+        for (auto const& db : c.databases())
+        {
+            auto const& table = db.get_table<CustomAttribute>();
+            auto first = table.begin();
+            while (first != table.end())
+            {
+                auto last = first + (std::min)(chunk_size, static_cast<std::uint32_t>(table.end() - first));
+                while ((last != table.end()) && (last.Parent() == (last - 1).Parent()))
+                {
+                    ++last;
+                }
+
+                chunks.emplace_back(first, last);
+                first = last;
+            }
+
+            m_databases.emplace(&db, std::vector<record>{});
+        }
+
+        std::vector<std::vector<record>> results(chunks.size());
+        xlang::task_group group;
+        for (std::size_t i = 0; i < chunks.size(); ++i)
+        {
+            group.add([&, i]()
+            {
+                decode_chunk(chunks[i], results[i]);
+            });
+        }
+        group.get();
+
+        for (std::size_t i = 0; i < chunks.size(); ++i)
+        {
+            auto& target = m_databases.at(&chunks[i].first.get_database());
+            target.insert(target.end(), std::make_move_iterator(results[i].begin()), std::make_move_iterator(results[i].end()));
+        }
+
+        XLANG_ASSERT(current() == nullptr);
+        current() = this;
+    }
+
+    ~attribute_cache() noexcept
+    {
+        current() = nullptr;
+    }
+
+    static attribute_cache const*& current() noexcept
+    {
+        static attribute_cache const* instance{};
+        return instance;
+    }
+
+    // Returns null if the row is not from the metadata that was decoded
+    template <typename T>
+    version_attributes const* find(T const& row) const
+    {
+        using namespace xlang::meta::reader;
+
+        auto db = m_databases.find(&row.get_database());
+        if (db == m_databases.end())
+        {
+            return nullptr;
+        }
+
+        auto parent = row.template coded_index<HasCustomAttribute>();
+        auto itr = std::lower_bound(db->second.begin(), db->second.end(), parent, [](record const& lhs, auto const& rhs)
+        {
+            return lhs.parent < rhs;
+        });
+
+        if ((itr == db->second.end()) || (itr->parent != parent))
+        {
+            static version_attributes const empty{};
+            return &empty;
+        }
+
+        return &itr->attributes;
+    }
+
+private:
+
+    struct record
+    {
+        xlang::meta::reader::coded_index<xlang::meta::reader::HasCustomAttribute> parent;
+        version_attributes attributes;
+    };
+
+    // Presents a row's attributes to the decoding functions above in place of the row itself
+    struct attribute_range
+    {
+        std::pair<xlang::meta::reader::CustomAttribute, xlang::meta::reader::CustomAttribute> range;
+
+        auto const& CustomAttribute() const noexcept
+        {
+            return range;
+        }
+    };
+
+    static void decode_chunk(std::pair<xlang::meta::reader::CustomAttribute, xlang::meta::reader::CustomAttribute> const& chunk, std::vector<record>& result)
+    {
+        using namespace std::literals;
+
+        for (auto first = chunk.first; first != chunk.second;)
+        {
+            auto parent = first.Parent();
+            auto last = first + 1;
+            while ((last != chunk.second) && (last.Parent() == parent))
+            {
+                ++last;
+            }
+
+            attribute_range row{ { first, last } };
+            bool hasContract = false;
+            bool hasVersion = false;
+            bool hasDeprecation = false;
+            bool experimental = false;
+            for (auto const& attr : row.range)
+            {
+                auto [ns, name] = attr.TypeNamespaceAndName();
+                if (ns != metadata_namespace)
+                {
+                    continue;
+                }
+
+                // Contract definitions use the single argument ContractVersionAttribute constructor, which describes
+                // the contract itself rather than a requirement on one
+                hasContract = hasContract || ((name == "ContractVersionAttribute"sv) && (attr.Value().FixedArgs().size() == 2));
+                hasVersion = hasVersion || (name == "VersionAttribute"sv);
+                hasDeprecation = hasDeprecation || (name == "DeprecatedAttribute"sv);
+                experimental = experimental || (name == "ExperimentalAttribute"sv);
+            }
+
+            if (hasContract || hasVersion || hasDeprecation || experimental)
+            {
+                auto& target = result.emplace_back(record{ parent, {} }).attributes;
+                if (hasContract)
+                {
+                    target.history = decode_contract_history(row);
+                }
+
+                if (hasVersion)
+                {
+                    target.platform_versions = decode_platform_versions(row);
+                }
+
+                if (hasDeprecation)
+                {
+                    target.deprecation = decode_deprecation(row);
+                }
+
+                target.experimental = experimental;
+            }
+
+            first = last;
+        }
+    }
+
+    std::unordered_map<xlang::meta::reader::database const*, std::vector<record>> m_databases;
+};
+
+template <typename T>
+inline version_attributes const* find_version_attributes(T const& value)
+{
+    auto cache = attribute_cache::current();
+    return cache ? cache->find(value) : nullptr;
+}
+
+template <typename T>
+inline std::optional<contract_history> get_contract_history(T const& value)
+{
+    if (auto attributes = find_version_attributes(value))
+    {
+        return attributes->history;
+    }
+
+    return decode_contract_history(value);
+}
+
+template <typename T>
+inline std::vector<platform_version> get_platform_versions(T const& value)
+{
+    if (auto attributes = find_version_attributes(value))
+    {
+        return attributes->platform_versions;
+    }
+
+    return decode_platform_versions(value);
+}
+
+template <typename T>
+inline std::optional<deprecation_info> is_deprecated(T const& value)
+{
+    if (auto attributes = find_version_attributes(value))
+    {
+        return attributes->deprecation;
+    }
+
+    return decode_deprecation(value);
+}
+
+template <typename T>
+inline bool is_experimental(T const& value)
+{
+    if (auto attributes = find_version_attributes(value))
+    {
+        return attributes->experimental;
+    }
+
+    return has_experimental_attribute(value);
+}
+
 template <typename T>
 std::optional<version> match_versioning_scheme(version const& ver, T const& value)
 {
@@ -245,15 +495,14 @@ std::optional<version> match_versioning_scheme(version const& ver, T const& valu
     {
         auto const& plat = std::get<platform_version>(ver);
         std::optional<version> result;
-        for_each_attribute(value, metadata_namespace, "VersionAttribute"sv, [&](bool /*first*/, auto const& attr)
+        for (auto const& possibleMatch : get_platform_versions(value))
         {
-            auto possibleMatch = decode_platform_version(attr);
             if (possibleMatch.platform == plat.platform)
             {
                 XLANG_ASSERT(!result);
                 result = possibleMatch;
             }
-        });
+        }
 
         return result;
     }
@@ -0,0 +1,164 @@
+#pragma once
+
+namespace xlang
+{
+    // The bundle is a single header that includes base.h and every generated namespace header,
+    // ordered so that each namespace follows the namespaces it depends on, along with a CMake
+    // snippet that builds it as a precompiled header or a header unit.
+
+    struct bundle
+    {
+        template <typename Depends>
+        void record(std::string_view const& ns, Depends const& depends)
+        {
+            std::lock_guard<std::mutex> guard{ m_lock };
+            auto& target = m_depends[ns];
+
+            for (auto&&[depends_ns, types] : depends)
+            {
+                target.insert(depends_ns);
+            }
+        }
+
+        void record(std::string_view const& ns, std::set<std::string_view> const& depends)
+        {
+            std::lock_guard<std::mutex> guard{ m_lock };
+            m_depends[ns].insert(depends.begin(), depends.end());
+        }
+
+        void save()
+        {
+            profile_scope profile{ "write_bundle" };
+            write_header(get_order());
+            write_cmake();
+        }
+
+    private:
+
+        // Depth-first post-order so that dependencies are included first. Namespaces may depend on
+        // each other, in which case the cycle is broken at the first namespace visited.
+        std::vector<std::string_view> get_order() const
+        {
+            std::vector<std::string_view> order;
+            std::set<std::string_view> visited;
+
+            std::function<void(std::string_view const&)> visit = [&](std::string_view const& ns)
+            {
+                auto found = m_depends.find(ns);
+
+                if (found == m_depends.end() || !visited.insert(ns).second)
+                {
+                    return;
+                }
+
+                for (auto&& depends : found->second)
+                {
+                    visit(depends);
+                }
+
+                order.push_back(ns);
+            };
+
+            for (auto&&[ns, depends] : m_depends)
+            {
+                visit(ns);
+            }
+
+            return order;
+        }
+
+        void write_header(std::vector<std::string_view> const& order) const
+        {
+            writer w;
+            write_preamble(w);
+            write_include_guard(w);
+            w.write_root_include("base");
+
+            for (auto&& ns : order)
+            {
+                w.write_root_include(ns);
+            }
+
+            w.flush_to_file(settings.output_folder + settings.bundle + ".h");
+        }
+
+        void write_cmake() const
+        {
+            std::string_view format = R"(
+# Usage:
+#   include(@name@.cmake)
+#   @name@_precompile(<target>)     # use @name@.h as the target's precompiled header
+#   @name@_header_unit(<target>)    # use @name@.h as a C++20 header unit (Visual C++ only)
+
+set(@NAME@_DIR "${CMAKE_CURRENT_LIST_DIR}")
+set(@NAME@_HEADER "${CMAKE_CURRENT_LIST_DIR}/@name@.h")
+
+function(@name@_precompile target)
+    target_include_directories(${target} PRIVATE "${@NAME@_DIR}")
+    target_precompile_headers(${target} PRIVATE "${@NAME@_HEADER}")
+endfunction()
+
+function(@name@_header_unit target)
+    if (NOT MSVC)
+        message(WARNING "@name@: header units require Visual C++, using a precompiled header for ${target}")
+        @name@_precompile(${target})
+        return()
+    endif()
+
+    set(ifc "${CMAKE_CURRENT_BINARY_DIR}/@name@.h.ifc")
+
+    if (NOT TARGET @name@_ifc)
+        add_custom_command(
+            OUTPUT "${ifc}"
+            COMMAND "${CMAKE_CXX_COMPILER}" /nologo /std:c++latest /EHsc /c /I "${@NAME@_DIR}"
+                /exportHeader /headerName:quote "@name@.h" /ifcOutput "${ifc}"
+            WORKING_DIRECTORY "${@NAME@_DIR}"
+            DEPENDS "${@NAME@_HEADER}")
+        add_custom_target(@name@_ifc DEPENDS "${ifc}")
+    endif()
+
+    add_dependencies(${target} @name@_ifc)
+    target_include_directories(${target} PRIVATE "${@NAME@_DIR}")
+    target_compile_options(${target} PRIVATE /std:c++latest "/headerUnit:quote" "@name@.h=${ifc}")
+endfunction()
+)";
+
+            // The snippet is mostly CMake variable references, so the bundle name is substituted
+            // for @name@ and @NAME@ rather than using writer placeholders.
+            auto const& name = settings.bundle;
+            auto upper = name;
+            std::transform(upper.begin(), upper.end(), upper.begin(), [](char c) { return static_cast<char>(::toupper(c)); });
+
+            writer w;
+            w.write("# WARNING: Please don't edit this file. It was generated by cppxlang v%\n", XLANG_VERSION_STRING);
+
+            for (size_t pos{}; pos < format.size();)
+            {
+                auto next = format.find('@', pos);
+                w.write(format.substr(pos, next - pos));
+
+                if (next == std::string_view::npos)
+                {
+                    break;
+                }
+
+                if (format.compare(next, 6, "@name@") == 0)
+                {
+                    w.write(name);
+                }
+                else
+                {
+                    XLANG_ASSERT(format.compare(next, 6, "@NAME@") == 0);
+                    w.write(upper);
+                }
+
+                pos = next + 6;
+            }
+
+            w.flush_to_file(settings.output_folder + settings.bundle + ".cmake");
+        }
+
+        std::mutex m_lock;
+        std::map<std::string_view, std::set<std::string_view>> m_depends;
+    };
+}
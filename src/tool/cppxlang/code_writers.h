@@ -1388,7 +1388,7 @@ namespace xlang
         {
             s();
             auto param_name = param.Name();
-            auto param_type = w.write_temp("%", param_signature->Type().Type());
+            auto param_type = w.write_transient("%", param_signature->Type().Type());
 
             if (param_signature->Type().is_szarray())
             {
@@ -1662,7 +1662,7 @@ struct XLANG_EBO produce_dispatch_to_overridable<T, D, %>
         };
     }
 
-    static void write_class_override_implements(writer& w, std::map<std::string, interface_info> const& interfaces)
+    static void write_class_override_implements(writer& w, interface_map const& interfaces)
     {
         bool found{};
 
@@ -1681,7 +1681,7 @@ struct XLANG_EBO produce_dispatch_to_overridable<T, D, %>
         }
     }
 
-    static void write_class_override_requires(writer& w, std::map<std::string, interface_info> const& interfaces)
+    static void write_class_override_requires(writer& w, interface_map const& interfaces)
     {
         bool found{};
 
@@ -1695,7 +1695,7 @@ struct XLANG_EBO produce_dispatch_to_overridable<T, D, %>
         }
     }
 
-    static void write_class_override_defaults(writer& w, std::map<std::string, interface_info> const& interfaces)
+    static void write_class_override_defaults(writer& w, interface_map const& interfaces)
     {
         bool first{ true };
 
@@ -1786,9 +1786,9 @@ struct XLANG_EBO produce_dispatch_to_overridable<T, D, %>
         }
     }
 
-    static void write_class_override_usings(writer& w, std::map<std::string, interface_info> const& required_interfaces)
+    static void write_class_override_usings(writer& w, interface_map const& required_interfaces)
     {
-        std::map<std::string_view, std::set<std::string>> method_usage;
+        std::map<std::string_view, std::set<std::string_view>> method_usage;
 
         for (auto&& [interface_name, info] : required_interfaces)
         {
@@ -1882,8 +1882,8 @@ struct XLANG_EBO produce_dispatch_to_overridable<T, D, %>
     {
         auto type_name = type.TypeName();
         auto interfaces_plus_self = get_interfaces(w, type);
-        interfaces_plus_self[std::string{ type_name }] = interface_info{ type };
-        std::map<std::string_view, std::set<std::string>> method_usage;
+        interfaces_plus_self[type_name] = interface_info{ type };
+        std::map<std::string_view, std::set<std::string_view>> method_usage;
 
         for (auto&& [interface_name, info] : interfaces_plus_self)
         {
@@ -1914,8 +1914,8 @@ struct XLANG_EBO produce_dispatch_to_overridable<T, D, %>
     {
         auto type_name = type.TypeName();
         auto default_interface = get_default_interface(type);
-        auto default_interface_name = w.write_temp("%", default_interface);
-        std::map<std::string_view, std::set<std::string>> method_usage;
+        auto default_interface_name = w.write_transient("%", default_interface);
+        std::map<std::string_view, std::set<std::string_view>> method_usage;
 
         for (auto&& [interface_name, info] : get_interfaces(w, type))
         {
@@ -4,6 +4,7 @@ namespace xlang
 {
     static void write_base_h()
     {
+        profile_scope profile{ "write_base_h" };
         writer w;
         write_preamble(w);
         write_open_file_guard(w, "BASE");
@@ -41,6 +42,7 @@ namespace xlang
 
     static void write_coroutine_h()
     {
+        profile_scope profile{ "write_coroutine_h" };
         writer w;
         write_preamble(w);
         write_open_file_guard(w, "COROUTINE");
@@ -60,8 +62,9 @@ namespace xlang
         w.flush_to_file(settings.output_folder + "xlang/coroutine.h");
     }
 
-    static void write_namespace_0_h(std::string_view const& ns, cache::namespace_members const& members)
+    static auto write_namespace_0_h(std::string_view const& ns, cache::namespace_members const& members)
     {
+        profile_scope profile{ "write_namespace_0_h", ns };
         writer w;
         w.type_namespace = ns;
 
@@ -87,10 +90,10 @@ namespace xlang
         w.write_each<write_guid>(members.interfaces);
         w.write_each<write_guid>(members.delegates);
         w.write_each<write_default_interface>(members.classes);
-        w.write_each<write_interface_abi>(members.interfaces);
-        w.write_each<write_delegate_abi>(members.delegates);
-        w.write_each<write_consume>(members.interfaces);
-        w.write_each<write_struct_abi>(members.structs);
+        w.write_each_parallel<write_interface_abi>(members.interfaces);
+        w.write_each_parallel<write_delegate_abi>(members.delegates);
+        w.write_each_parallel<write_consume>(members.interfaces);
+        w.write_each_parallel<write_struct_abi>(members.structs);
         write_close_namespace(w);
 
         write_close_file_guard(w);
@@ -106,15 +109,17 @@ namespace xlang
         }
 
         w.save_header('0');
+        return std::move(w.depends);
     }
 
-    static void write_namespace_1_h(std::string_view const& ns, cache::namespace_members const& members)
+    static auto write_namespace_1_h(std::string_view const& ns, cache::namespace_members const& members)
     {
+        profile_scope profile{ "write_namespace_1_h", ns };
         writer w;
         w.type_namespace = ns;
 
         write_type_namespace(w, ns);
-        w.write_each<write_interface>(members.interfaces);
+        w.write_each_parallel<write_interface>(members.interfaces);
         write_close_namespace(w);
 
         write_close_file_guard(w);
@@ -129,18 +134,25 @@ namespace xlang
 
         w.write_depends(w.type_namespace, '0');
         w.save_header('1');
+        return std::move(w.depends);
     }
 
-    static void write_namespace_2_h(std::string_view const& ns, cache::namespace_members const& members, cache const& c)
+    static auto write_namespace_2_h(std::string_view const& ns, cache::namespace_members const& members, cache const& c)
     {
+        profile_scope profile{ "write_namespace_2_h", ns };
         writer w;
         w.type_namespace = ns;
 
         write_type_namespace(w, ns);
-        w.write_each<write_delegate>(members.delegates);
+        w.write_each_parallel<write_delegate>(members.delegates);
         bool const promote = write_structs(w, members.structs);
-        w.write_each<write_class>(members.classes);
-        w.write_each<write_interface_override>(members.classes);
+
+        if (!is_split(ns))
+        {
+            w.write_each_parallel<write_class>(members.classes);
+            w.write_each_parallel<write_interface_override>(members.classes);
+        }
+
         write_close_namespace(w);
         write_namespace_special(w, ns, c);
 
@@ -153,30 +165,172 @@ namespace xlang
 
         for (auto&& depends : w.depends)
         {
-            w.write_depends(depends.first, impl);
+            w.write_depends(depends.first, depends.second, impl);
         }
 
         w.write_depends(w.type_namespace, '1');
         w.save_header('2');
+        return std::move(w.depends);
     }
 
-    static void write_namespace_h(cache const& c, std::string_view const& ns, cache::namespace_members const& members)
+    static auto write_namespace_3_h(cache const& c, std::string_view const& ns, cache::namespace_members const& members)
     {
+        profile_scope profile{ "write_namespace_3_h", ns };
         writer w;
         w.type_namespace = ns;
+        w.split = true;
 
         write_impl_namespace(w);
-        w.write_each<write_consume_definitions>(members.interfaces);
-        w.write_each<write_delegate_implementation>(members.delegates);
-        w.write_each<write_produce>(members.interfaces);
-        w.write_each<write_dispatch_overridable>(members.classes);
+        w.write_each_parallel<write_consume_definitions>(members.interfaces);
+        w.write_each_parallel<write_delegate_implementation>(members.delegates);
+        w.write_each_parallel<write_produce>(members.interfaces);
         write_close_namespace(w);
         write_type_namespace(w, ns);
-        w.write_each<write_class_definitions>(members.classes);
+        w.write_each_parallel<write_delegate_definition>(members.delegates);
+        write_close_namespace(w);
+        write_std_namespace(w);
+        w.write_each<write_std_hash>(members.interfaces);
+        write_close_namespace(w);
+
+        write_close_file_guard(w);
+        w.swap();
+        write_preamble(w);
+        write_open_file_guard(w, ns, '3');
+        write_version_assert(w);
+        write_parent_depends(w, c, ns);
+
+        for (auto&& depends : w.depends)
+        {
+            w.write_depends(depends.first, depends.second, '2');
+        }
+
+        w.write_depends(w.type_namespace, '2');
+        w.write_local_depends();
+        w.save_header('3');
+        return std::move(w.depends);
+    }
+
+    static auto write_class_2_h(std::string_view const& ns, TypeDef const& type)
+    {
+        profile_scope profile{ "write_class_2_h", ns };
+        writer w;
+        w.type_namespace = ns;
+
+        write_type_namespace(w, ns);
+        write_class(w, type);
+        write_interface_override(w, type);
+        write_close_namespace(w);
+
+        write_close_file_guard(w);
+        w.swap();
+        write_preamble(w);
+        write_open_file_guard(w, w.write_temp("%.%.class", ns, type.TypeName()), '2');
 
-        w.write_each<write_delegate_definition>(members.delegates);
-        w.write_each<write_interface_override_methods>(members.classes);
-        w.write_each<write_class_override>(members.classes);
+        for (auto&& depends : w.depends)
+        {
+            w.write_depends(depends.first, '1');
+        }
+
+        w.write_depends(w.type_namespace, '2');
+        w.save_class_header(type, '2');
+        return std::move(w.depends);
+    }
+
+    static auto write_class_h(std::string_view const& ns, TypeDef const& type)
+    {
+        profile_scope profile{ "write_class_h", ns };
+        writer w;
+        w.type_namespace = ns;
+        w.split = true;
+
+        write_impl_namespace(w);
+        write_dispatch_overridable(w, type);
+        write_close_namespace(w);
+        write_type_namespace(w, ns);
+        write_class_definitions(w, type);
+        write_interface_override_methods(w, type);
+        write_class_override(w, type);
+        write_close_namespace(w);
+        write_std_namespace(w);
+        write_std_hash(w, type);
+        write_close_namespace(w);
+
+        write_close_file_guard(w);
+        w.swap();
+        write_preamble(w);
+        write_open_file_guard(w, w.write_temp("%.%.class", ns, type.TypeName()));
+        w.write_depends(w.type_namespace, '3');
+
+        for (auto&& depends : w.depends)
+        {
+            w.write_depends(depends.first, depends.second, '2');
+        }
+
+        w.write_root_include(w.write_temp("impl/%/%.2", ns, type.TypeName()));
+        w.write_local_depends(type);
+        w.save_class_header(type);
+        return std::move(w.depends);
+    }
+
+    // A split namespace's header is an umbrella that includes the namespace's own definitions
+    // and then a header for each class, so that consumers may instead include only the classes
+    // they use from <namespace>/<class>.h.
+    static auto write_split_namespace_h(cache const& c, std::string_view const& ns, cache::namespace_members const& members)
+    {
+        profile_scope profile{ "write_split_namespace_h", ns };
+        create_directories(path{ settings.output_folder } / "xlang" / ns);
+        create_directories(path{ settings.output_folder } / "xlang/impl" / ns);
+        auto result = write_namespace_3_h(c, ns, members);
+
+        auto merge = [&](auto&& depends)
+        {
+            for (auto&&[depends_ns, types] : depends)
+            {
+                result[depends_ns].insert(types.begin(), types.end());
+            }
+        };
+
+        writer w;
+        w.type_namespace = ns;
+        write_preamble(w);
+        write_open_file_guard(w, ns);
+        w.write_depends(w.type_namespace, '3');
+
+        for (auto&& type : members.classes)
+        {
+            merge(write_class_2_h(ns, type));
+            merge(write_class_h(ns, type));
+            w.write_root_include(w.write_temp("%/%", ns, type.TypeName()));
+        }
+
+        write_close_file_guard(w);
+        w.save_header();
+        return result;
+    }
+
+    static auto write_namespace_h(cache const& c, std::string_view const& ns, cache::namespace_members const& members)
+    {
+        if (is_split(ns))
+        {
+            return write_split_namespace_h(c, ns, members);
+        }
+
+        profile_scope profile{ "write_namespace_h", ns };
+        writer w;
+        w.type_namespace = ns;
+
+        write_impl_namespace(w);
+        w.write_each_parallel<write_consume_definitions>(members.interfaces);
+        w.write_each_parallel<write_delegate_implementation>(members.delegates);
+        w.write_each_parallel<write_produce>(members.interfaces);
+        w.write_each_parallel<write_dispatch_overridable>(members.classes);
+        write_close_namespace(w);
+        write_type_namespace(w, ns);
+        w.write_each_parallel<write_class_definitions>(members.classes);
+
+        w.write_each_parallel<write_delegate_definition>(members.delegates);
+        w.write_each_parallel<write_interface_override_methods>(members.classes);
+        w.write_each_parallel<write_class_override>(members.classes);
         write_close_namespace(w);
         write_std_namespace(w);
         w.write_each<write_std_hash>(members.interfaces);
@@ -192,15 +346,43 @@ namespace xlang
 
         for (auto&& depends : w.depends)
         {
-            w.write_depends(depends.first, '2');
+            w.write_depends(depends.first, depends.second, '2');
         }
 
         w.write_depends(w.type_namespace, '2');
         w.save_header();
+        return std::move(w.depends);
+    }
+
+    // The headers that write_namespace_0_h through write_namespace_h write for the namespace, relative to the
+    // output folder.
+    static std::vector<std::string> namespace_headers(std::string_view const& ns, cache::namespace_members const& members)
+    {
+        std::vector<std::string> result
+        {
+            writer::header_path(ns),
+            writer::header_path(ns, '0'),
+            writer::header_path(ns, '1'),
+            writer::header_path(ns, '2'),
+        };
+
+        if (is_split(ns))
+        {
+            result.push_back(writer::header_path(ns, '3'));
+
+            for (auto&& type : members.classes)
+            {
+                result.push_back(writer::class_header_path(ns, type, '2'));
+                result.push_back(writer::class_header_path(ns, type));
+            }
+        }
+
+        return result;
     }
 
     static void write_module_g_cpp(std::vector<TypeDef> const& classes)
     {
+        profile_scope profile{ "write_module_g_cpp" };
         writer w;
         write_preamble(w);
         write_pch(w);
@@ -210,6 +392,7 @@ namespace xlang
 
     static void write_component_g_h(TypeDef const& type)
     {
+        profile_scope profile{ "write_component_g_h", type.TypeNamespace() };
         writer w;
         w.add_depends(type);
         write_component_g_h(w, type);
@@ -232,6 +415,8 @@ namespace xlang
 
     static void write_component_g_cpp(TypeDef const& type)
     {
+        profile_scope profile{ "write_component_g_cpp", type.TypeNamespace() };
+
         if (!settings.component_opt)
         {
             return;
@@ -250,6 +435,8 @@ namespace xlang
 
     static void write_component_h(TypeDef const& type)
     {
+        profile_scope profile{ "write_component_h", type.TypeNamespace() };
+
         if (settings.component_folder.empty())
         {
             return;
@@ -270,6 +457,8 @@ namespace xlang
 
     static void write_component_cpp(TypeDef const& type)
     {
+        profile_scope profile{ "write_component_cpp", type.TypeNamespace() };
+
         if (settings.component_folder.empty())
         {
             return;
@@ -14,20 +14,24 @@ namespace xlang
 
     struct method_signature
     {
-        explicit method_signature(MethodDef const& method) :
-            m_method(method.Signature())
+        explicit method_signature(MethodDef const& method)
         {
-            auto params = method.ParamList();
+            auto model = type_model::current(method.get_cache());
+            auto info = model ? model->find(method) : nullptr;
 
-            if (m_method.ReturnType() && params.first != params.second && params.first.Sequence() == 0)
+            if (!info)
             {
-                m_return = params.first;
-                ++params.first;
+                auto owned = std::make_shared<type_model::method_info const>(type_model::decode(method));
+                info = owned.get();
+                m_owned = std::move(owned);
             }
 
-            for (uint32_t i{}; i != size(m_method.Params()); ++i)
+            m_method = &info->signature;
+            m_return = info->return_param;
+
+            for (uint32_t i{}; i != size(m_method->Params()); ++i)
             {
-                m_params.emplace_back(params.first + i, &m_method.Params().first[i]);
+                m_params.emplace_back(info->first_param + i, &m_method->Params().first[i]);
             }
         }
 
@@ -43,7 +47,7 @@ namespace xlang
 
         auto const& return_signature() const
         {
-            return m_method.ReturnType();
+            return m_method->ReturnType();
         }
 
         auto return_param_name() const
@@ -64,7 +68,9 @@ namespace xlang
 
     private:
 
-        MethodDefSig m_method;
+        // The signature is shared with the type model or, if there is none, with any copies of this object.
+        std::shared_ptr<type_model::method_info const> m_owned;
+        MethodDefSig const* m_method{};
         std::vector<std::pair<Param, ParamSig const*>> m_params;
         Param m_return;
     };
@@ -97,11 +103,21 @@ namespace xlang
     {
         auto impls = type.InterfaceImpl();
 
-        for (auto&& impl : impls)
+        if (auto model = type_model::current(type))
         {
-            if (has_attribute(impl, "Windows.Foundation.Metadata", "DefaultAttribute"))
+            if (auto info = model->find(type); info && info->default_interface)
             {
-                return impl.Interface();
+                return type_model::get_default_interface(*info);
+            }
+        }
+        else
+        {
+            for (auto&& impl : impls)
+            {
+                if (has_attribute(impl, "Windows.Foundation.Metadata", "DefaultAttribute"))
+                {
+                    return impl.Interface();
+                }
             }
         }
 
@@ -207,6 +223,14 @@ namespace xlang
 
     static auto get_bases(TypeDef const& type)
     {
+        if (auto model = type_model::current(type))
+        {
+            if (auto info = model->find(type))
+            {
+                return info->bases;
+            }
+        }
+
         std::vector<TypeDef> bases;
 
         for (auto base = get_base_class(type); base; base = get_base_class(base))
@@ -224,16 +248,19 @@ namespace xlang
         bool defaulted{};
         bool overridable{};
         bool base{};
-        std::vector<std::vector<std::string>> generic_param_stack{};
+        std::vector<std::vector<std::string_view>> generic_param_stack{};
     };
 
-    static void get_interfaces_impl(writer& w, std::map<std::string, interface_info>& result, bool defaulted, bool overridable, bool base, std::vector<std::vector<std::string>> const& generic_param_stack, std::pair<InterfaceImpl, InterfaceImpl>&& children)
+    // Interface names and generic arguments are kept in the writer's arena, so the result must not outlive the writer.
+    using interface_map = std::map<std::string_view, interface_info>;
+
+    static void get_interfaces_impl(writer& w, interface_map& result, bool defaulted, bool overridable, bool base, std::vector<std::vector<std::string_view>> const& generic_param_stack, std::pair<InterfaceImpl, InterfaceImpl>&& children)
     {
         for (auto&& impl : children)
         {
             interface_info info;
             auto type = impl.Interface();
-            auto name = w.write_temp("%", type);
+            auto name = w.write_transient("%", type);
             info.is_default = has_attribute(impl, "Windows.Foundation.Metadata", "DefaultAttribute");
             info.defaulted = !base && (defaulted || info.is_default);
 
@@ -278,11 +305,11 @@ namespace xlang
             {
                 auto type_signature = type.TypeSpec().Signature();
 
-                std::vector<std::string> names;
+                std::vector<std::string_view> names;
 
                 for (auto&& arg : type_signature.GenericTypeInst().GenericArgs())
                 {
-                    names.push_back(w.write_temp("%", arg));
+                    names.push_back(w.write_transient("%", arg));
                 }
 
                 info.generic_param_stack.push_back(std::move(names));
@@ -302,7 +329,7 @@ namespace xlang
 
     static auto get_interfaces(writer& w, TypeDef const& type)
     {
-        std::map<std::string, interface_info> result;
+        interface_map result;
         get_interfaces_impl(w, result, false, false, false, {}, type.InterfaceImpl());
 
         for (auto&& base : get_bases(type))
@@ -539,6 +566,11 @@ namespace xlang
         return false;
     }
 
+    static bool is_split(std::string_view const& ns)
+    {
+        return settings.split_namespaces.find(ns) != settings.split_namespaces.end();
+    }
+
     static bool has_projected_types(cache::namespace_members const& members)
     {
         return
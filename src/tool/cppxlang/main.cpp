@@ -1,4 +1,7 @@
 #include "pch.h"
+#if !defined(XLANG_DRIVER)
+#include "profiler_new.h"
+#endif
 #include <time.h>
 #include "strings.h"
 #include "settings.h"
@@ -7,6 +10,8 @@
 #include "code_writers.h"
 #include "component_writers.h"
 #include "file_writers.h"
+#include "manifest.h"
+#include "bundle.h"
 #include "type_writers.h"
 
 namespace xlang
@@ -35,6 +40,10 @@ namespace xlang
         { "filter" }, // One or more prefixes to include in input (same as -include)
         { "license", 0, 0 }, // Generate license comment
         { "brackets", 0, 0 }, // Use angle brackets for #includes (defaults to quotes)
+        { "incremental", 0, 0, {}, "Skip namespaces whose metadata has not changed since the previous run" },
+        { "profile", 0, 1, "<path>", "Write a Chrome trace-event timing profile of generation" },
+        { "split", 0, 1, "[<count>]", "Split namespaces with at least <count> classes (defaults to 1) into per-class headers" },
+        { "bundle", 0, 1, "<name>", "Generate an aggregated header and CMake snippet to build it as a precompiled header" },
     };
 
     static void print_usage(writer& w)
@@ -92,6 +101,15 @@ Where <spec> is one or more of:
 
         settings.license = args.exists("license");
         settings.brackets = args.exists("brackets");
+        settings.incremental = args.exists("incremental");
+        settings.profile = args.value("profile");
+
+        settings.bundle = args.value("bundle");
+
+        if (args.exists("split"))
+        {
+            settings.split = static_cast<uint32_t>(std::stoul(args.value("split", "1")));
+        }
 
         auto output_folder = canonical(args.value("output"));
         create_directories(output_folder / "xlang/impl");
@@ -204,6 +222,24 @@ Where <spec> is one or more of:
 
     }
 
+    // Whether a namespace is split only depends on its own metadata, so that headers generated
+    // separately for input and reference metadata agree on where each class is declared.
+    static void build_split_namespaces(cache const& c)
+    {
+        if (settings.split == 0)
+        {
+            return;
+        }
+
+        for (auto&&[ns, members] : c.namespaces())
+        {
+            if (members.classes.size() >= settings.split)
+            {
+                settings.split_namespaces.insert(ns);
+            }
+        }
+    }
+
     static void remove_foundation_types(cache& c)
     {
         c.remove_type("Foundation", "DateTime");
@@ -211,7 +247,33 @@ Where <spec> is one or more of:
         c.remove_type("Foundation", "TimeSpan");
     }
 
-    static int run(int const argc, char** argv)
+    static bool has_foundation_types(cache const& c)
+    {
+        return c.find("Foundation", "DateTime") || c.find("Foundation", "EventRegistrationToken") || c.find("Foundation", "TimeSpan");
+    }
+
+    // A cache shared with other generators must not be modified, so a private cache is loaded instead if there
+    // are Foundation types to remove.
+    static cache const& load_cache(std::optional<cache>& storage)
+    {
+        auto files = get_files_to_cache();
+        auto const& c = cache_pool::load(files, storage);
+
+        if (!storage)
+        {
+            if (!has_foundation_types(c))
+            {
+                return c;
+            }
+
+            storage.emplace(files);
+        }
+
+        remove_foundation_types(*storage);
+        return *storage;
+    }
+
+    int run(int const argc, char** argv)
     {
         int result{};
         writer w;
@@ -220,10 +282,26 @@ Where <spec> is one or more of:
         {
             auto start = get_start_time();
             process_args(argc, argv);
-            cache c{ get_files_to_cache() };
-            remove_foundation_types(c);
+            std::optional<profiler> profile;
+
+            if (!settings.profile.empty() && !cache_pool::current())
+            {
+                profile.emplace(settings.profile);
+            }
+
+            std::optional<profile_scope> profile_load{ std::in_place, "load_metadata" };
+            std::optional<cache> storage;
+            auto const& c = load_cache(storage);
             build_filters(c);
+            build_split_namespaces(c);
             settings.base = settings.base || (!settings.component && settings.projection_filter.empty());
+            profile_load.reset();
+            std::optional<type_model> model;
+
+            if (!type_model::current(c))
+            {
+                model.emplace(c);
+            }
 
             if (settings.verbose)
             {
@@ -249,6 +327,27 @@ Where <spec> is one or more of:
             }
 
             w.flush_to_console();
+            std::optional<output_sink> sink;
+
+            if (!output_sink::current())
+            {
+                sink.emplace();
+            }
+
+            std::optional<manifest> incremental;
+
+            if (settings.incremental)
+            {
+                incremental.emplace(c);
+            }
+
+            std::optional<bundle> aggregate;
+
+            if (!settings.bundle.empty())
+            {
+                aggregate.emplace();
+            }
+
             task_group group;
 
             for (auto&&[ns, members] : c.namespaces())
@@ -260,10 +359,44 @@ Where <spec> is one or more of:
                         return;
                     }
 
-                    write_namespace_0_h(ns, members);
-                    write_namespace_1_h(ns, members);
-                    write_namespace_2_h(ns, members, c);
-                    write_namespace_h(c, ns, members);
+                    profile_scope profile{ ns, ns };
+
+                    if (incremental && incremental->up_to_date(ns))
+                    {
+                        if (aggregate)
+                        {
+                            aggregate->record(ns, incremental->depends(ns));
+                        }
+
+                        return;
+                    }
+
+                    // The namespace's headers are independent of each other, so a large namespace need not write
+                    // them one after another.
+                    decltype(write_namespace_0_h(ns, members)) depends_0, depends_1, depends_2, depends;
+                    task_group headers;
+                    headers.add([&] { depends_0 = write_namespace_0_h(ns, members); });
+                    headers.add([&] { depends_1 = write_namespace_1_h(ns, members); });
+                    headers.add([&] { depends_2 = write_namespace_2_h(ns, members, c); });
+                    headers.add([&] { depends = write_namespace_h(c, ns, members); });
+                    headers.get();
+
+                    if (incremental)
+                    {
+                        incremental->record(ns, depends_0);
+                        incremental->record(ns, depends_1);
+                        incremental->record(ns, depends_2);
+                        incremental->record(ns, depends);
+                        incremental->record_headers(ns, namespace_headers(ns, members));
+                    }
+
+                    if (aggregate)
+                    {
+                        aggregate->record(ns, depends_0);
+                        aggregate->record(ns, depends_1);
+                        aggregate->record(ns, depends_2);
+                        aggregate->record(ns, depends);
+                    }
                 });
             }
 
@@ -307,6 +440,23 @@ Where <spec> is one or more of:
 
             group.get();
 
+            if (incremental)
+            {
+                incremental->save();
+            }
+
+            if (aggregate)
+            {
+                aggregate->save();
+            }
+
+            output_sink::current()->get();
+
+            if (profile)
+            {
+                profile->save();
+            }
+
             if (settings.verbose)
             {
                 w.write(" time:  %ms\n", get_elapsed_time(start));
@@ -327,7 +477,9 @@ Where <spec> is one or more of:
     }
 }
 
+#if !defined(XLANG_DRIVER)
 int main(int const argc, char** argv)
 {
     return xlang::run(argc, argv);
 }
+#endif
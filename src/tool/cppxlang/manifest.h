@@ -0,0 +1,677 @@
+#pragma once
+
+namespace xlang
+{
+    // The manifest records a fingerprint of the metadata each namespace header was generated from
+    // so that an incremental run can skip namespaces whose inputs have not changed. A namespace's
+    // fingerprint covers its own types along with the transitive closure of every type they refer
+    // to, as well as the types recorded in writer::depends the last time it was generated.
+
+    struct manifest
+    {
+        explicit manifest(cache const& c) : m_cache(c)
+        {
+            profile_scope profile{ "manifest" };
+
+            for (auto&&[ns, members] : c.namespaces())
+            {
+                auto& range = m_namespaces[ns];
+                range.first = static_cast<uint32_t>(m_types.size());
+
+                for (auto&&[name, type] : members.types)
+                {
+                    m_index.emplace_back(type, static_cast<uint32_t>(m_types.size()));
+                    m_types.push_back(type);
+                }
+
+                range.second = static_cast<uint32_t>(m_types.size());
+            }
+
+            std::sort(m_index.begin(), m_index.end());
+            m_hashes.resize(m_types.size());
+            m_references.resize(m_types.size());
+
+            task_group group;
+
+            for (auto&&[ns, range] : m_namespaces)
+            {
+                group.add([&, first = range.first, last = range.second]
+                {
+                    for (auto id = first; id != last; ++id)
+                    {
+                        hasher h{ *this, m_references[id] };
+                        h.add(m_types[id]);
+                        m_hashes[id] = h.value;
+                    }
+                });
+            }
+
+            group.get();
+            load();
+        }
+
+        // Computes the fingerprint for the namespace and returns true if it matches the previous
+        // run and all of the namespace's headers are still present.
+        bool up_to_date(std::string_view const& ns)
+        {
+            auto fingerprint = get_fingerprint(ns);
+            std::lock_guard<std::mutex> guard{ m_lock };
+            auto& entry = m_entries[ns];
+            auto const unchanged = entry.fingerprint == fingerprint;
+            entry.fingerprint = fingerprint;
+
+            return unchanged && headers_exist(entry);
+        }
+
+        // Records the headers written for the namespace, so that the next run regenerates the namespace if any of
+        // them has been deleted.
+        void record_headers(std::string_view const& ns, std::vector<std::string> headers)
+        {
+            std::lock_guard<std::mutex> guard{ m_lock };
+            m_entries[ns].headers = std::move(headers);
+        }
+
+        template <typename Depends>
+        void record(std::string_view const& ns, Depends const& depends)
+        {
+            std::set<std::string> names;
+
+            for (auto&&[depends_ns, types] : depends)
+            {
+                for (auto&& type : types)
+                {
+                    std::string name{ type.TypeNamespace() };
+                    name += '.';
+                    name += type.TypeName();
+                    names.insert(std::move(name));
+                }
+            }
+
+            std::lock_guard<std::mutex> guard{ m_lock };
+            auto& entry = m_entries[ns];
+
+            if (entry.updated)
+            {
+                entry.depends.insert(names.begin(), names.end());
+            }
+            else
+            {
+                entry.depends = std::move(names);
+                entry.updated = true;
+            }
+        }
+
+        // The namespaces that the namespace's headers depended on the last time they were generated.
+        std::set<std::string_view> depends(std::string_view const& ns)
+        {
+            std::set<std::string_view> result;
+            std::lock_guard<std::mutex> guard{ m_lock };
+            auto entry = m_entries.find(ns);
+
+            if (entry == m_entries.end())
+            {
+                return result;
+            }
+
+            for (auto&& name : entry->second.depends)
+            {
+                if (name.find('.') == std::string::npos)
+                {
+                    continue;
+                }
+
+                if (auto type = m_cache.find(name))
+                {
+                    result.insert(type.TypeNamespace());
+                }
+            }
+
+            return result;
+        }
+
+        // Namespaces that were skipped keep their previous depends. Namespaces that were recorded
+        // have their fingerprint recomputed to include their new depends, so the next run starts
+        // from the same set of roots.
+        void save()
+        {
+            writer w;
+
+            for (auto&&[ns, entry] : m_entries)
+            {
+                if (entry.fingerprint == 0 || m_namespaces.find(ns) == m_namespaces.end())
+                {
+                    continue;
+                }
+
+                if (entry.updated)
+                {
+                    entry.fingerprint = get_fingerprint(ns);
+                }
+
+                w.write_printf("%s %016llx", std::string{ ns }.c_str(), static_cast<unsigned long long>(entry.fingerprint));
+
+                for (auto&& name : entry.depends)
+                {
+                    w.write(" %", name);
+                }
+
+                w.write(" %", header_separator);
+
+                for (auto&& header : entry.headers)
+                {
+                    w.write(" %", header);
+                }
+
+                w.write('\n');
+            }
+
+            w.flush_to_file(filename());
+        }
+
+    private:
+
+        struct entry
+        {
+            uint64_t fingerprint{};
+            std::set<std::string> depends;
+            std::vector<std::string> headers;
+            bool updated{};
+        };
+
+        // Separates a namespace's depends from its headers in the manifest file.
+        static constexpr std::string_view header_separator{ ":" };
+
+        struct hasher
+        {
+            manifest const& owner;
+            std::vector<uint32_t>& references;
+            uint64_t value{ 0xcbf29ce484222325 };
+
+            void add_bytes(void const* data, size_t size)
+            {
+                auto bytes = static_cast<uint8_t const*>(data);
+
+                for (size_t i = 0; i != size; ++i)
+                {
+                    value ^= bytes[i];
+                    value *= 0x100000001b3;
+                }
+            }
+
+            void add(std::string_view const& text)
+            {
+                add(static_cast<uint64_t>(text.size()));
+                add_bytes(text.data(), text.size());
+            }
+
+            template <typename T, std::enable_if_t<std::is_arithmetic_v<T>>* = nullptr>
+            void add(T value)
+            {
+                add_bytes(&value, sizeof(value));
+            }
+
+            void add_reference(std::string_view const& ns, std::string_view const& name)
+            {
+                add(ns);
+                add(name);
+
+                if (auto type = owner.m_cache.find(ns, name))
+                {
+                    if (auto id = owner.find_id(type); id != no_id)
+                    {
+                        references.push_back(id);
+                    }
+                }
+            }
+
+            void add_reference(std::string_view const& type_string)
+            {
+                auto pos = type_string.rfind('.');
+
+                if (pos == std::string_view::npos)
+                {
+                    add(type_string);
+                }
+                else
+                {
+                    add_reference(type_string.substr(0, pos), type_string.substr(pos + 1));
+                }
+            }
+
+            void add(coded_index<TypeDefOrRef> const& type)
+            {
+                if (!type)
+                {
+                    add(uint8_t{ 0 });
+                    return;
+                }
+
+                add(static_cast<uint8_t>(type.type()));
+
+                switch (type.type())
+                {
+                case TypeDefOrRef::TypeDef:
+                    add_reference(type.TypeDef().TypeNamespace(), type.TypeDef().TypeName());
+                    break;
+                case TypeDefOrRef::TypeRef:
+                    add_reference(type.TypeRef().TypeNamespace(), type.TypeRef().TypeName());
+                    break;
+                case TypeDefOrRef::TypeSpec:
+                    add(type.TypeSpec().Signature().GenericTypeInst());
+                    break;
+                }
+            }
+
+            void add(GenericTypeInstSig const& type)
+            {
+                add(type.GenericType());
+                add(static_cast<uint32_t>(type.GenericArgCount()));
+
+                for (auto&& arg : type.GenericArgs())
+                {
+                    add(arg);
+                }
+            }
+
+            void add(TypeSig const& signature)
+            {
+                add(signature.is_szarray());
+
+                call(signature.Type(),
+                    [&](ElementType type)
+                    {
+                        add(uint8_t{ 1 });
+                        add(static_cast<uint8_t>(type));
+                    },
+                    [&](coded_index<TypeDefOrRef> const& type)
+                    {
+                        add(uint8_t{ 2 });
+                        add(type);
+                    },
+                    [&](GenericTypeIndex var)
+                    {
+                        add(uint8_t{ 3 });
+                        add(var.index);
+                    },
+                    [&](GenericTypeInstSig const& type)
+                    {
+                        add(uint8_t{ 4 });
+                        add(type);
+                    },
+                    [&](GenericMethodTypeIndex var)
+                    {
+                        add(uint8_t{ 5 });
+                        add(var.index);
+                    });
+            }
+
+            void add(ElemSig const& arg)
+            {
+                add(static_cast<uint32_t>(arg.value.index()));
+
+                call(arg.value,
+                    [&](ElemSig::SystemType type)
+                    {
+                        add_reference(type.name);
+                    },
+                    [&](ElemSig::EnumValue const& type)
+                    {
+                        std::visit([&](auto&& value) { add(value); }, type.value);
+                    },
+                    [&](std::string_view const& value)
+                    {
+                        add(value);
+                    },
+                    [&](auto&& value)
+                    {
+                        add(value);
+                    });
+            }
+
+            void add(FixedArgSig const& arg)
+            {
+                call(arg.value,
+                    [&](ElemSig const& value)
+                    {
+                        add(uint8_t{ 0 });
+                        add(value);
+                    },
+                    [&](std::vector<ElemSig> const& values)
+                    {
+                        add(static_cast<uint32_t>(values.size() + 1));
+
+                        for (auto&& value : values)
+                        {
+                            add(value);
+                        }
+                    });
+            }
+
+            template <typename T>
+            void add_attributes(T const& row)
+            {
+                for (auto&& attribute : row.CustomAttribute())
+                {
+                    auto[ns, name] = attribute.TypeNamespaceAndName();
+                    add_reference(ns, name);
+                    auto signature = attribute.Value();
+
+                    for (auto&& arg : signature.FixedArgs())
+                    {
+                        add(arg);
+                    }
+
+                    for (auto&& arg : signature.NamedArgs())
+                    {
+                        add(arg.name);
+                        add(arg.value);
+                    }
+                }
+            }
+
+            void add(Constant const& constant)
+            {
+                if (!constant)
+                {
+                    add(uint8_t{ 0 });
+                    return;
+                }
+
+                auto value = constant.Value();
+                add(static_cast<uint32_t>(value.index() + 1));
+
+                call(value,
+                    [&](std::string_view const& value)
+                    {
+                        add(value);
+                    },
+                    [&](std::nullptr_t)
+                    {
+                    },
+                    [&](auto&& value)
+                    {
+                        add(value);
+                    });
+            }
+
+            void add(TypeDef const& type)
+            {
+                add(type.Flags().value);
+                add(type.TypeNamespace());
+                add(type.TypeName());
+                add(type.Extends());
+                add_attributes(type);
+
+                for (auto&& param : type.GenericParam())
+                {
+                    add(param.Name());
+                }
+
+                for (auto&& impl : type.InterfaceImpl())
+                {
+                    add(impl.Interface());
+                    add_attributes(impl);
+                }
+
+                for (auto&& field : type.FieldList())
+                {
+                    add(field.Flags().value);
+                    add(field.Name());
+                    add(field.Signature().Type());
+                    add(field.Constant());
+                    add_attributes(field);
+                }
+
+                for (auto&& method : type.MethodList())
+                {
+                    add(method.Flags().value);
+                    add(method.ImplFlags().value);
+                    add(method.Name());
+                    add_attributes(method);
+                    auto signature = method.Signature();
+                    add(static_cast<bool>(signature.ReturnType()));
+
+                    if (signature.ReturnType())
+                    {
+                        add(signature.ReturnType().ByRef());
+                        add(signature.ReturnType().Type());
+                    }
+
+                    for (auto&& param : signature.Params())
+                    {
+                        add(param.ByRef());
+                        add(param.Type());
+                    }
+
+                    for (auto&& param : method.ParamList())
+                    {
+                        add(param.Flags().value);
+                        add(param.Sequence());
+                        add(param.Name());
+                    }
+                }
+
+                for (auto&& property : type.PropertyList())
+                {
+                    add(property.Name());
+                    add(property.Type().Type());
+                    add_attributes(property);
+                }
+
+                for (auto&& event : type.EventList())
+                {
+                    add(event.Name());
+                    add(event.EventType());
+                    add_attributes(event);
+                }
+            }
+        };
+
+        static constexpr uint32_t no_id{ 0xffffffff };
+
+        static uint64_t mix(uint64_t value) noexcept
+        {
+            value ^= value >> 30;
+            value *= 0xbf58476d1ce4e5b9;
+            value ^= value >> 27;
+            value *= 0x94d049bb133111eb;
+            return value ^ (value >> 31);
+        }
+
+        // A manifest written before the headers were recorded has none, and so is never up to date.
+        static bool headers_exist(entry const& value)
+        {
+            if (value.headers.empty())
+            {
+                return false;
+            }
+
+            return std::all_of(value.headers.begin(), value.headers.end(), [](std::string const& header)
+            {
+                return exists(settings.output_folder + header);
+            });
+        }
+
+        static std::string filename()
+        {
+            return settings.output_folder + "xlang/impl/cppxlang.manifest";
+        }
+
+        uint32_t find_id(TypeDef const& type) const noexcept
+        {
+            auto found = std::lower_bound(m_index.begin(), m_index.end(), type, [](auto&& left, auto&& right)
+            {
+                return left.first < right;
+            });
+
+            if (found == m_index.end() || !(found->first == type))
+            {
+                return no_id;
+            }
+
+            return found->second;
+        }
+
+        // The closure walk reads the depends recorded by a previous run, which is only
+        // modified under the lock by record and not while namespaces are being fingerprinted.
+        uint64_t get_fingerprint(std::string_view const& ns)
+        {
+            auto range = m_namespaces.find(ns);
+
+            if (range == m_namespaces.end())
+            {
+                return 0;
+            }
+
+            std::vector<bool> visited(m_types.size());
+            std::vector<uint32_t> pending;
+
+            auto push = [&](uint32_t id)
+            {
+                if (!visited[id])
+                {
+                    visited[id] = true;
+                    pending.push_back(id);
+                }
+            };
+
+            for (auto id = range->second.first; id != range->second.second; ++id)
+            {
+                push(id);
+            }
+
+            {
+                std::lock_guard<std::mutex> guard{ m_lock };
+                auto entry = m_entries.find(ns);
+
+                if (entry != m_entries.end())
+                {
+                    for (auto&& name : entry->second.depends)
+                    {
+                        auto pos = name.rfind('.');
+
+                        if (pos == std::string::npos)
+                        {
+                            continue;
+                        }
+
+                        if (auto type = m_cache.find(std::string_view{ name }.substr(0, pos), std::string_view{ name }.substr(pos + 1)))
+                        {
+                            if (auto id = find_id(type); id != no_id)
+                            {
+                                push(id);
+                            }
+                        }
+                    }
+                }
+            }
+
+            // Ids are positions in m_types, which shift whenever a type is added, so they are only used to walk
+            // the closure. Each type's hash covers its full name, and the sum does not depend on the walk's order.
+            uint64_t closure{};
+
+            while (!pending.empty())
+            {
+                auto id = pending.back();
+                pending.pop_back();
+                closure += mix(m_hashes[id]);
+
+                for (auto&& reference : m_references[id])
+                {
+                    push(reference);
+                }
+            }
+
+            hasher h{ *this, pending };
+            h.add(std::string_view{ XLANG_VERSION_STRING });
+            h.add(settings.license);
+            h.add(settings.brackets);
+            h.add(settings.component_opt);
+            h.add(is_split(ns));
+            h.add(closure);
+
+            for (auto id = range->second.first; id != range->second.second; ++id)
+            {
+                h.add(settings.projection_filter.includes(m_types[id]));
+                h.add(settings.component_filter.includes(m_types[id]));
+            }
+
+            // The namespace header includes its nearest ancestor with projected types.
+            auto parent = ns;
+
+            while (true)
+            {
+                auto pos = parent.rfind('.');
+
+                if (pos == std::string_view::npos)
+                {
+                    break;
+                }
+
+                parent = parent.substr(0, pos);
+                auto found = m_cache.namespaces().find(parent);
+
+                if (found != m_cache.namespaces().end() && has_projected_types(found->second))
+                {
+                    h.add(parent);
+                    break;
+                }
+            }
+
+            return h.value ? h.value : 1;
+        }
+
+        void load()
+        {
+            if (!std::filesystem::exists(filename()))
+            {
+                return;
+            }
+
+            std::ifstream file{ filename() };
+            std::string line;
+
+            while (std::getline(file, line))
+            {
+                std::istringstream stream{ line };
+                std::string ns;
+                std::string fingerprint;
+
+                if (!(stream >> ns >> fingerprint))
+                {
+                    continue;
+                }
+
+                auto range = m_namespaces.find(ns);
+
+                if (range == m_namespaces.end())
+                {
+                    continue;
+                }
+
+                auto& entry = m_entries[range->first];
+                entry.fingerprint = std::strtoull(fingerprint.c_str(), nullptr, 16);
+                std::string name;
+
+                while (stream >> name && name != header_separator)
+                {
+                    entry.depends.insert(std::move(name));
+                }
+
+                while (stream >> name)
+                {
+                    entry.headers.push_back(std::move(name));
+                }
+            }
+        }
+
+        cache const& m_cache;
+        std::map<std::string_view, std::pair<uint32_t, uint32_t>> m_namespaces;
+        std::vector<TypeDef> m_types;
+        std::vector<std::pair<TypeDef, uint32_t>> m_index;
+        std::vector<uint64_t> m_hashes;
+        std::vector<std::vector<uint32_t>> m_references;
+        std::map<std::string_view, entry> m_entries;
+        std::mutex m_lock;
+    };
+}
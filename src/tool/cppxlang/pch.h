@@ -1,6 +1,8 @@
 #pragma once
 
+#include "cache_pool.h"
 #include "cmd_reader.h"
 #include "meta_reader.h"
 #include "task_group.h"
 #include "text_writer.h"
+#include "type_model.h"
@@ -11,6 +11,10 @@ namespace xlang
         bool base{};
         bool license{};
         bool brackets{};
+        bool incremental{};
+        uint32_t split{};
+        std::set<std::string_view> split_namespaces;
+        std::string bundle;
 
         bool component{};
         std::string component_folder;
@@ -22,6 +26,7 @@ namespace xlang
         bool component_opt{};
 
         bool verbose{};
+        std::string profile;
 
         std::set<std::string> include;
         std::set<std::string> exclude;
@@ -77,7 +77,9 @@ namespace xlang
         bool consume_types{};
         bool async_types{};
         std::map<std::string_view, std::set<TypeDef>> depends;
-        std::vector<std::vector<std::string>> generic_param_stack;
+        std::set<TypeDef, std::less<TypeDef>, arena_allocator<TypeDef>> local_depends{ arena_allocator<TypeDef>{ transient_arena() } };
+        bool split{};
+        std::vector<std::vector<std::string_view>> generic_param_stack;
 
         struct generic_param_guard
         {
@@ -117,6 +119,41 @@ namespace xlang
             {
                 depends[ns].insert(type);
             }
+            else if (split)
+            {
+                local_depends.insert(type);
+            }
+        }
+
+        // A fragment starts with the writer's state as it was before the list was written, rather than the state
+        // left by the previous item, so functions that are written in parallel must set the flags they depend on.
+        // The writer then takes the state left by the last fragment, as it would after write_each.
+        void fork(writer& fragment) const
+        {
+            fragment.type_namespace = type_namespace;
+            fragment.split = split;
+            copy_state(fragment);
+        }
+
+        void merge(writer const& fragment)
+        {
+            fragment.copy_state(*this);
+
+            for (auto&&[ns, types] : fragment.depends)
+            {
+                depends[ns].insert(types.begin(), types.end());
+            }
+
+            local_depends.insert(fragment.local_depends.begin(), fragment.local_depends.end());
+        }
+
+        void copy_state(writer& target) const
+        {
+            target.abi_types = abi_types;
+            target.param_names = param_names;
+            target.consume_types = consume_types;
+            target.async_types = async_types;
+            target.generic_param_stack = generic_param_stack;
         }
 
         [[nodiscard]] auto push_generic_params(std::pair<GenericParam, GenericParam> const& params)
@@ -126,11 +163,11 @@ namespace xlang
                 return generic_param_guard{ nullptr };
             }
 
-            std::vector<std::string> names;
+            std::vector<std::string_view> names;
 
             for (auto&& param : params)
             {
-                names.push_back(std::string{ param.Name() });
+                names.push_back(param.Name());
             }
 
             generic_param_stack.push_back(std::move(names));
@@ -139,11 +176,11 @@ namespace xlang
 
         [[nodiscard]] auto push_generic_params(GenericTypeInstSig const& signature)
         {
-            std::vector<std::string> names;
+            std::vector<std::string_view> names;
 
             for (auto&& arg : signature.GenericArgs())
             {
-                names.push_back(write_temp("%", arg));
+                names.push_back(write_transient("%", arg));
             }
 
             generic_param_stack.push_back(std::move(names));
@@ -298,7 +335,7 @@ namespace xlang
                     static constexpr std::string_view map("Foundation::Collections::IMap<"sv);
 
                     consume_types = false;
-                    auto full_name = write_temp("@::%<%>", ns, name, bind_list(", ", type.GenericArgs()));
+                    auto full_name = write_transient("@::%<%>", ns, name, bind_list(", ", type.GenericArgs()));
                     consume_types = true;
 
                     if (starts_with(full_name, iterable))
@@ -465,25 +502,101 @@ namespace xlang
             }
         }
 
-        void save_header(char impl = 0)
+        // Classes in a split namespace are declared in their own impl/<namespace>/<class>.2.h
+        // headers, so a dependency on the namespace's second level only includes the shards for
+        // the classes that are actually referenced.
+        void write_depends(std::string_view const& ns, std::set<TypeDef> const& types, char impl)
         {
-            auto filename{ settings.output_folder + "xlang/" };
+            if (impl != '2' || settings.split_namespaces.find(ns) == settings.split_namespaces.end())
+            {
+                write_depends(ns, impl);
+                return;
+            }
+
+            bool other{};
+
+            for (auto&& type : types)
+            {
+                if (get_category(type) == category::class_type)
+                {
+                    write_root_include(write_temp("impl/%/%.2", ns, type.TypeName()));
+                }
+                else
+                {
+                    other = true;
+                }
+            }
+
+            if (other)
+            {
+                write_depends(ns, impl);
+            }
+        }
+
+        void write_local_depends(TypeDef const& exclude = {})
+        {
+            for (auto&& type : local_depends)
+            {
+                if (type != exclude && get_category(type) == category::class_type)
+                {
+                    write_root_include(write_temp("impl/%/%.2", type_namespace, type.TypeName()));
+                }
+            }
+        }
+
+        // The header's path relative to the output folder.
+        static std::string header_path(std::string_view const& ns, char impl = 0)
+        {
+            std::string result{ "xlang/" };
+
+            if (impl)
+            {
+                result += "impl/";
+            }
+
+            result += ns;
 
             if (impl)
             {
-                filename += "impl/";
+                result += '.';
+                result += impl;
             }
 
-            filename += type_namespace;
+            result += ".h";
+            return result;
+        }
+
+        static std::string class_header_path(std::string_view const& ns, TypeDef const& type, char impl = 0)
+        {
+            std::string result{ "xlang/" };
+
+            if (impl)
+            {
+                result += "impl/";
+            }
+
+            result += ns;
+            result += '/';
+            result += type.TypeName();
 
             if (impl)
             {
-                filename += '.';
-                filename += impl;
+                result += '.';
+                result += impl;
             }
 
-            filename += ".h";
-            flush_to_file(filename);
+            result += ".h";
+            return result;
+        }
+
+        void save_header(char impl = 0)
+        {
+            flush_to_file(settings.output_folder + header_path(type_namespace, impl));
+        }
+
+        void save_class_header(TypeDef const& type, char impl = 0)
+        {
+            flush_to_file(settings.output_folder + class_header_path(type_namespace, type, impl));
         }
     };
 }
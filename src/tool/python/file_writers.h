@@ -6,6 +6,7 @@ namespace pywinrt
 
     inline void write_pch_cpp(stdfs::path const& folder)
     {
+        profile_scope profile{ "write_pch_cpp" };
         writer w;
         write_license(w);
         w.write("#include \"pch.h\"\n");
@@ -14,6 +15,7 @@ namespace pywinrt
 
     inline void write_pch_h(stdfs::path const& folder)
     {
+        profile_scope profile{ "write_pch_h" };
         writer w;
         write_license(w);
         w.write("#pragma once\n#include \"pybase.h\"\n");
@@ -22,6 +24,7 @@ namespace pywinrt
 
     inline void write_pybase_h(stdfs::path const& folder)
     {
+        profile_scope profile{ "write_pybase_h" };
         writer w;
         write_license(w);
         w.write(strings::pybase);
@@ -30,6 +33,7 @@ namespace pywinrt
 
     inline void write_namespace_h(stdfs::path const& folder, std::string_view const& ns, std::set<std::string> const& needed_namespaces, cache::namespace_members const& members)
     {
+        profile_scope profile{ "write_namespace_h", ns };
         writer w;
         w.current_namespace = ns;
 
@@ -103,6 +107,7 @@ namespace pywinrt
 
     inline auto write_namespace_cpp(stdfs::path const& folder, std::string_view const& ns, cache::namespace_members const& members)
     {
+        profile_scope profile{ "write_namespace_cpp", ns };
         writer w;
         w.current_namespace = ns;
         auto filename = w.write_temp("py.%.cpp", ns);
@@ -141,6 +146,7 @@ namespace pywinrt
 
     inline void write_module_cpp(stdfs::path const& folder)
     {
+        profile_scope profile{ "write_module_cpp" };
         writer w;
 
         write_license(w);
@@ -158,6 +164,7 @@ namespace pywinrt
     
     inline void write_setup_py(stdfs::path const& folder, std::vector<std::string> const& /*namespaces*/)
     {
+        profile_scope profile{ "write_setup_py" };
         writer w;
 
         write_license(w, "#");
@@ -167,6 +174,7 @@ namespace pywinrt
 
     inline void write_package_dunder_init_py(stdfs::path const& folder)
     {
+        profile_scope profile{ "write_package_dunder_init_py" };
         writer w;
 
         write_license(w, "#");
@@ -176,6 +184,7 @@ namespace pywinrt
 
     inline void write_namespace_dunder_init_py(stdfs::path const& folder, std::string_view const& module_name, std::set<std::string> const& needed_namespaces, std::string_view const& ns, cache::namespace_members const& members)
     {
+        profile_scope profile{ "write_namespace_dunder_init_py", ns };
         writer w;
         w.current_namespace = ns;
         
@@ -1,8 +1,9 @@
 #pragma once
 
-namespace xlang
+namespace pywinrt
 {
-    using namespace meta::reader;
+    using namespace xlang;
+    using namespace xlang::meta::reader;
 
     inline auto get_start_time()
     {
@@ -200,20 +201,24 @@ namespace xlang
     {
         using param_t = std::pair<Param, ParamSig const*>;
 
-        explicit method_signature(MethodDef const& method) :
-            m_method(method.Signature())
+        explicit method_signature(MethodDef const& method)
         {
-            auto params = method.ParamList();
+            auto model = type_model::current(method.get_cache());
+            auto info = model ? model->find(method) : nullptr;
 
-            if (m_method.ReturnType() && params.first != params.second && params.first.Sequence() == 0)
+            if (!info)
             {
-                m_return = params.first;
-                ++params.first;
+                auto owned = std::make_shared<type_model::method_info const>(type_model::decode(method));
+                info = owned.get();
+                m_owned = std::move(owned);
             }
 
-            for (uint32_t i{}; i != size(m_method.Params()); ++i)
+            m_method = &info->signature;
+            m_return = info->return_param;
+
+            for (uint32_t i{}; i != size(m_method->Params()); ++i)
             {
-                m_params.emplace_back(params.first + i, &m_method.Params().first[i]);
+                m_params.emplace_back(info->first_param + i, &m_method->Params().first[i]);
             }
         }
 
@@ -229,7 +234,7 @@ namespace xlang
 
         auto const& return_signature() const
         {
-            return m_method.ReturnType();
+            return m_method->ReturnType();
         }
 
         auto return_param_name() const
@@ -255,7 +260,9 @@ namespace xlang
 
     private:
 
-        MethodDefSig m_method;
+        // The signature is shared with the type model or, if there is none, with any copies of this object.
+        std::shared_ptr<type_model::method_info const> m_owned;
+        MethodDefSig const* m_method{};
         std::vector<param_t> m_params;
         Param m_return;
     };
@@ -277,6 +284,11 @@ namespace xlang
 
     bool implements_interface(TypeDef const& type, std::string_view const& ns, std::string_view const& name)
     {
+        if (auto model = type_model::current(type))
+        {
+            return model->implements(type, ns, name);
+        }
+
         auto type_name_matches = [&ns, &name](TypeDef const& td) { return td.TypeNamespace() == ns && td.TypeName() == name; };
 
         if (get_category(type) == category::interface_type && type_name_matches(type))
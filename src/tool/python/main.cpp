@@ -1,4 +1,7 @@
 #include "pch.h"
+#if !defined(XLANG_DRIVER)
+#include "profiler_new.h"
+#endif
 #include "helpers.h"
 
 #include "strings.h"
@@ -23,6 +26,7 @@ namespace pywinrt
         { "exclude", 0, cmd::option::no_max, "<prefix>", "One or more prefixes to exclude from projection" },
         { "verbose", 0, 0, {}, "Show detailed progress information" },
         { "module", 0, 1, "<name>", "Name of generated projection. Defaults to winrt."},
+        { "profile", 0, 1, "<path>", "Write a Chrome trace-event timing profile of generation" },
         { "help", 0, cmd::option::no_max, {}, "Show detailed help" },
     };
 
@@ -74,6 +78,7 @@ Where <spec> is one or more of:
         settings.verbose = args.exists("verbose");
         settings.module = args.value("module", "winrt");
         settings.input = args.files("input", database::is_database);
+        settings.profile = args.value("profile");
 
         for (auto && include : args.values("include"))
         {
@@ -96,14 +101,33 @@ Where <spec> is one or more of:
         return files;
     }
 
+    // A namespace is only generated if the filter includes at least one of its projected types, so a namespace
+    // holding nothing but filtered types or attributes is skipped before any work is scheduled for it.
     bool has_projected_types(cache::namespace_members const& members)
     {
+        auto includes = [](std::vector<TypeDef> const& types)
+        {
+            return !types.empty() && settings.filter.includes(types);
+        };
+
         return
-            !members.interfaces.empty() ||
-            !members.classes.empty() ||
-            !members.enums.empty() ||
-            !members.structs.empty() ||
-            !members.delegates.empty();
+            includes(members.interfaces) ||
+            includes(members.classes) ||
+            includes(members.enums) ||
+            includes(members.structs) ||
+            includes(members.delegates);
+    }
+
+    auto get_namespace_folder(stdfs::path folder, std::string_view const& ns)
+    {
+        for (auto&& ns_segment : get_dotted_name_segments(ns))
+        {
+            std::string segment{ ns_segment };
+            std::transform(segment.begin(), segment.end(), segment.begin(), [](char c) {return static_cast<char>(::tolower(c)); });
+            folder /= segment;
+        }
+
+        return folder;
     }
 
     int run(int const argc, char** argv)
@@ -115,7 +139,23 @@ Where <spec> is one or more of:
         {
             auto start = get_start_time();
             process_args(argc, argv);
-            cache c{ get_files_to_cache() };
+            std::optional<profiler> profile;
+
+            if (!settings.profile.empty() && !cache_pool::current())
+            {
+                profile.emplace(settings.profile);
+            }
+
+            std::optional<profile_scope> profile_load{ std::in_place, "load_metadata" };
+            std::optional<cache> storage;
+            auto const& c = cache_pool::load(get_files_to_cache(), storage);
+            profile_load.reset();
+            std::optional<type_model> model;
+
+            if (!type_model::current(c))
+            {
+                model.emplace(c);
+            }
             settings.filter = { settings.include, settings.exclude };
 
             if (settings.verbose)
@@ -130,53 +170,77 @@ Where <spec> is one or more of:
 
             w.flush_to_console();
 
-            task_group group;
+            std::optional<output_sink> sink;
+
+            if (!output_sink::current())
+            {
+                sink.emplace();
+            }
 
             auto module_dir = settings.output_folder / settings.module;
             auto src_dir = module_dir / "src";
             create_directories(src_dir);
 
-            group.add([&]
-            {
-                write_pch_h(src_dir);
-                write_pch_cpp(src_dir);
-                write_pybase_h(src_dir);
-                write_package_dunder_init_py(module_dir);
-                write_module_cpp(src_dir);
-            });
-
-            std::vector<std::string> generated_namespaces{};
+            // The namespaces refer directly to the cache's members, which outlive the tasks that write them.
+            std::vector<std::pair<std::string_view, cache::namespace_members const*>> namespaces;
 
             for (auto&&[ns, members] : c.namespaces())
             {
-                if (!has_projected_types(members) || !settings.filter.includes(members))
+                if (has_projected_types(members))
                 {
-                    continue;
+                    namespaces.emplace_back(ns, &members);
                 }
+            }
+
+            std::vector<std::string> generated_namespaces(namespaces.size());
+            std::transform(namespaces.begin(), namespaces.end(), generated_namespaces.begin(), [](auto&& entry)
+            {
+                return std::string{ entry.first };
+            });
 
-                generated_namespaces.emplace_back(ns);
+            std::vector<int64_t> elapsed(namespaces.size());
+            task_group group;
 
-                auto ns_dir = module_dir;
-                for (auto&& ns_segment : get_dotted_name_segments(ns))
-                {
-                    std::string segment{ ns_segment };
-                    std::transform(segment.begin(), segment.end(), segment.begin(), [](char c) {return static_cast<char>(::tolower(c)); });
-                    ns_dir /= segment;
-                }
-                
-                create_directories(ns_dir);
+            group.add([&] { write_pch_h(src_dir); });
+            group.add([&] { write_pch_cpp(src_dir); });
+            group.add([&] { write_pybase_h(src_dir); });
+            group.add([&] { write_module_cpp(src_dir); });
+            group.add([&] { write_package_dunder_init_py(module_dir); });
+            group.add([&] { write_setup_py(settings.output_folder, generated_namespaces); });
 
-                group.add([&src_dir, ns_dir, ns = ns, members = members]
+            for (std::size_t index = 0; index != namespaces.size(); ++index)
+            {
+                group.add([&, index]
                 {
-                    auto namespaces = write_namespace_cpp(src_dir, ns, members);
-                    write_namespace_h(src_dir, ns, namespaces, members);
-                    write_namespace_dunder_init_py(ns_dir, settings.module, namespaces, ns, members);
+                    auto ns_start = get_start_time();
+                    auto const& [ns, members] = namespaces[index];
+                    profile_scope profile{ ns, ns };
+                    auto ns_dir = get_namespace_folder(module_dir, ns);
+                    create_directories(ns_dir);
+
+                    auto needed_namespaces = write_namespace_cpp(src_dir, ns, *members);
+                    write_namespace_h(src_dir, ns, needed_namespaces, *members);
+                    write_namespace_dunder_init_py(ns_dir, settings.module, needed_namespaces, ns, *members);
+                    elapsed[index] = get_elapsed_time(ns_start);
                 });
             }
 
             group.get();
 
-            write_setup_py(settings.output_folder, generated_namespaces);
+            if (settings.verbose)
+            {
+                for (std::size_t index = 0; index != namespaces.size(); ++index)
+                {
+                    w.write("namespace: % (%ms)\n", namespaces[index].first, elapsed[index]);
+                }
+            }
+
+            output_sink::current()->get();
+
+            if (profile)
+            {
+                profile->save();
+            }
 
             if (settings.verbose)
             {
@@ -198,7 +262,9 @@ Where <spec> is one or more of:
     }
 }
 
+#if !defined(XLANG_DRIVER)
 int main(int const argc, char** argv)
 {
     return pywinrt::run(argc, argv);
-}
\ No newline at end of file
+}
+#endif
\ No newline at end of file
@@ -1,8 +1,10 @@
 #pragma once
 
+#include "cache_pool.h"
 #include "cmd_reader.h"
 #include "meta_reader.h"
 #include "task_group.h"
 #include "text_writer.h"
+#include "type_model.h"
 
 #include <set>
@@ -9,6 +9,7 @@ namespace pywinrt
         std::filesystem::path output_folder;
         std::string module{ "pyrt" };
         bool verbose{};
+        std::string profile;
 
         std::set<std::string> include;
         std::set<std::string> exclude;
@@ -0,0 +1,213 @@
+#include "pch.h"
+#include "profiler_new.h"
+
+// The generators' entry points, which are compiled without their own main functions for the driver.
+namespace xlang
+{
+    int run(int const argc, char** argv);
+}
+
+namespace pywinrt
+{
+    int run(int const argc, char** argv);
+}
+
+int abi_main(int const argc, char** argv);
+
+namespace xlanggen
+{
+    using namespace std::chrono;
+    using namespace xlang;
+    using namespace xlang::meta::reader;
+    using namespace xlang::text;
+
+    struct writer : writer_base<writer>
+    {
+    };
+
+    struct usage_exception {};
+
+    static constexpr cmd::option options[]
+    {
+        { "verbose", 0, 0, {}, "Show the time taken by each generator" },
+        { "profile", 0, 1, "<path>", "Write a Chrome trace-event timing profile of generation" },
+        { "help", 0, cmd::option::no_max, {}, "Show detailed help with examples" },
+    };
+
+    struct generator
+    {
+        std::string_view name;
+        int(*run)(int const argc, char** argv);
+    };
+
+    static constexpr generator generators[]
+    {
+        { "cppxlang", xlang::run },
+        { "abi", abi_main },
+        { "pywinrt", pywinrt::run },
+    };
+
+    struct pipeline
+    {
+        generator const* tool;
+        std::vector<char*> args;
+        int result{};
+        milliseconds elapsed{};
+    };
+
+    static void print_usage(writer& w)
+    {
+        static auto printColumns = [](writer& w, std::string_view const& col1, std::string_view const& col2)
+        {
+            w.write_printf("  %-20s%s\n", col1.data(), col2.data());
+        };
+
+        static auto printOption = [](writer& w, cmd::option const& opt)
+        {
+            if (opt.desc.empty())
+            {
+                return;
+            }
+            printColumns(w, w.write_temp("-% %", opt.name, opt.arg), opt.desc);
+        };
+
+        auto format = R"(
+Usage: xlanggen [options...] +<generator> [generator options...] ...
+
+Runs several generators concurrently, loading the metadata that they have in common once.
+
+Generators:
+  +cppxlang           C++ projection
+  +abi                ABI headers
+  +pywinrt            Python projection
+
+Options:
+
+%
+Example:
+  xlanggen -verbose +cppxlang -in local -out cpp +abi -in local -out abi
+)";
+        w.write(format, bind_each(printOption, options));
+    }
+
+    // Arguments before the first '+' are for the driver and each '+' starts the arguments for a generator.
+    static std::vector<pipeline> split_args(int const argc, char** argv, std::vector<char*>& driver_args)
+    {
+        std::vector<pipeline> result;
+        driver_args.push_back(argv[0]);
+
+        for (int i = 1; i < argc; ++i)
+        {
+            if (argv[i][0] != '+')
+            {
+                (result.empty() ? driver_args : result.back().args).push_back(argv[i]);
+                continue;
+            }
+
+            std::string_view name{ argv[i] + 1 };
+            auto found = std::find_if(std::begin(generators), std::end(generators), [&](generator const& value)
+            {
+                return value.name == name;
+            });
+
+            if (found == std::end(generators))
+            {
+                throw_invalid("Generator '", name, "' is not supported");
+            }
+
+            result.push_back({ found, { argv[i] + 1 } });
+        }
+
+        return result;
+    }
+
+    static int run(int const argc, char** argv)
+    {
+        int result{};
+        writer w;
+
+        try
+        {
+            auto const start = high_resolution_clock::now();
+            std::vector<char*> driver_args;
+            auto pipelines = split_args(argc, argv, driver_args);
+            cmd::reader args{ static_cast<int>(driver_args.size()), driver_args.data(), options };
+
+            if (args.exists("help") || pipelines.empty())
+            {
+                throw usage_exception{};
+            }
+
+            std::optional<profiler> profile;
+
+            if (args.exists("profile"))
+            {
+                profile.emplace(args.value("profile"));
+            }
+
+            cache_pool pool{ pipelines.size() };
+            std::vector<std::thread> threads;
+
+            // Each generator runs on its own thread, rather than a task_group, since they wait for each other in
+            // the cache_pool. Each also writes through its own output_sink, so that a failed write is reported by the
+            // generator that wrote the file.
+            for (auto&& pipeline : pipelines)
+            {
+                threads.emplace_back([&pool, &pipeline]
+                {
+                    auto const start = high_resolution_clock::now();
+                    profile_scope profile{ pipeline.tool->name };
+                    pipeline.result = pipeline.tool->run(static_cast<int>(pipeline.args.size()), pipeline.args.data());
+                    pool.finish();
+                    pipeline.elapsed = duration_cast<milliseconds>(high_resolution_clock::now() - start);
+                });
+            }
+
+            for (auto&& thread : threads)
+            {
+                thread.join();
+            }
+
+            if (profile)
+            {
+                profile->save();
+            }
+
+            for (auto&& pipeline : pipelines)
+            {
+                if (args.exists("verbose"))
+                {
+                    w.write("%: %ms\n", pipeline.tool->name, pipeline.elapsed.count());
+                }
+
+                if (pipeline.result != 0)
+                {
+                    result = pipeline.result;
+                }
+            }
+
+            if (args.exists("verbose"))
+            {
+                w.write("time: %ms\n", duration_cast<milliseconds>(high_resolution_clock::now() - start).count());
+            }
+        }
+        catch (usage_exception const&)
+        {
+            print_usage(w);
+            result = 1;
+        }
+        catch (std::exception const& e)
+        {
+            w.write(" error: %\n", e.what());
+            result = 1;
+        }
+
+        w.flush_to_console();
+        return result;
+    }
+}
+
+int main(int const argc, char** argv)
+{
+    return xlanggen::run(argc, argv);
+}